@@ -7,6 +7,7 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Bots/ShooterBot.h"
 #include "Bots/ShooterAIController.h"
+#include "Bots/ShooterBotPerception.h"
 #include "Online/ShooterPlayerState.h"
 
 UBTDecorator_HasLoSTo::UBTDecorator_HasLoSTo(const FObjectInitializer& ObjectInitializer)
@@ -104,27 +105,22 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 {
 	AShooterAIController* MyController = Cast<AShooterAIController>(InActor);
 	AShooterBot* MyBot = MyController ? Cast<AShooterBot>(MyController->GetPawn()) : NULL; 
+	UShooterBotPerception* Perception = UShooterBotPerception::Get(InActor);
 
 	bool bHasLOS = false;
 	{
-		if (MyBot != NULL)
+		// Shares the weapon trace of the controller, see AShooterAIController::HasWeaponLOSToEnemy
+		FShooterLOSResult Hit;
+		if (MyBot != NULL && Perception != NULL && Perception->GetLOSResult(MyBot, InEnemyActor, EndLocation, Hit))
 		{
-			// Perform trace to retrieve hit info
-			FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AILosTrace), true, InActor);
-			
-			TraceParams.bReturnPhysicalMaterial = true;
-			TraceParams.AddIgnoredActor(MyBot);
-			const FVector StartLocation = MyBot->GetActorLocation();
-			FHitResult Hit(ForceInit);
-			GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
 			if (Hit.bBlockingHit == true)
 			{
 				// We hit something. If we have an actor supplied, just check if the hit actor is an enemy. If it is consider that 'has LOS'
-				AActor* HitActor = Hit.GetActor();
-				if (Hit.GetActor() != NULL)
+				AActor* HitActor = Hit.HitActor;
+				if (HitActor != NULL)
 				{
 					// If the hit is our target actor consider it LOS
-					if (HitActor == InActor)
+					if (HitActor == InEnemyActor)
 					{
 						bHasLOS = true;
 					}
@@ -152,9 +148,7 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 					if (InEnemyActor == NULL)
 					{
 						// We were not given an actor - so check of the distance between what we hit and the target. If what we hit is further away than the target we should be able to hit our target.
-						FVector HitDelta = Hit.ImpactPoint - StartLocation;
-						FVector TargetDelta = EndLocation - StartLocation;
-						if (TargetDelta.SizeSquared() < HitDelta.SizeSquared())
+						if (Hit.TargetDistSq < Hit.HitDistSq)
 						{
 							bHasLOS = true;
 						}
@@ -8,11 +8,15 @@
 #include "Bots/ShooterAIController.h"
 #include "Bots/ShooterBot.h"
 #include "Pickups/ShooterPickup_Ammo.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "NavigationSystem.h"
 #include "Weapons/ShooterWeapon_Instant.h"
 
 UBTTask_FindPickup::UBTTask_FindPickup(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer)
 {
+	bUsePathCost = false;
+	MaxPathCostCandidates = 3;
 }
 
 EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
@@ -24,26 +28,33 @@ EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent& Owne
 		return EBTNodeResult::Failed;
 	}
 
-	AShooterGameMode* GameMode = MyBot->GetWorld()->GetAuthGameMode<AShooterGameMode>();
-	if (GameMode == NULL)
+	UShooterPickupRegistry* Registry = UShooterPickupRegistry::Get(MyBot);
+	if (Registry == NULL)
 	{
 		return EBTNodeResult::Failed;
 	}
 
 	const FVector MyLoc = MyBot->GetActorLocation();
-	AShooterPickup_Ammo* BestPickup = NULL;
-	float BestDistSq = MAX_FLT;
+	const int32 NumCandidates = bUsePathCost ? FMath::Max(MaxPathCostCandidates, 1) : 1;
 
-	for (int32 i = 0; i < GameMode->LevelPickups.Num(); ++i)
+	TArray<AShooterPickup*> Candidates;
+	Registry->FindNearestPickups(AShooterPickup_Ammo::StaticClass(), AShooterWeapon_Instant::StaticClass(), MyLoc, NumCandidates,
+		[MyBot](AShooterPickup* Pickup) { return Pickup->CanBePickedUp(MyBot); }, Candidates);
+
+	AShooterPickup* BestPickup = Candidates.Num() > 0 ? Candidates[0] : NULL;
+
+	// candidates are sorted by straight line distance, the closest one is kept if no path can be found
+	const UNavigationSystemV1* NavSys = bUsePathCost ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(MyBot->GetWorld()) : NULL;
+	if (NavSys && Candidates.Num() > 1)
 	{
-		AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(GameMode->LevelPickups[i]);
-		if (AmmoPickup && AmmoPickup->IsForWeapon(AShooterWeapon_Instant::StaticClass()) && AmmoPickup->CanBePickedUp(MyBot))
+		float BestPathCost = MAX_FLT;
+		for (AShooterPickup* Pickup : Candidates)
 		{
-			const float DistSq = (AmmoPickup->GetActorLocation() - MyLoc).SizeSquared();
-			if (BestDistSq == -1 || DistSq < BestDistSq)
+			float PathCost = 0.0f;
+			if (NavSys->GetPathCost(MyLoc, Pickup->GetActorLocation(), PathCost) == ENavigationQueryResult::Success && PathCost < BestPathCost)
 			{
-				BestDistSq = DistSq;
-				BestPickup = AmmoPickup;
+				BestPathCost = PathCost;
+				BestPickup = Pickup;
 			}
 		}
 	}
@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "Bots/ShooterAIController.h"
 #include "Bots/ShooterBot.h"
+#include "Bots/ShooterBotPerception.h"
+#include "Bots/ShooterCharacterGrid.h"
 #include "Online/ShooterPlayerState.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
@@ -11,6 +13,9 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "Weapons/ShooterWeapon.h"
 
+/** how many of the nearest enemy candidates are traced synchronously when they were never traced before */
+static const int32 MaxSyncLOSCandidates = 2;
+
 AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
  	BlackboardComp = ObjectInitializer.CreateDefaultSubobject<UBlackboardComponent>(this, TEXT("BlackBoardComp"));
@@ -67,28 +72,13 @@ void AShooterAIController::Respawn()
 void AShooterAIController::FindClosestEnemy()
 {
 	APawn* MyBot = GetPawn();
-	if (MyBot == NULL)
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (MyBot == NULL || CharacterGrid == NULL)
 	{
 		return;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	float BestDistSq = MAX_FLT;
-	AShooterCharacter* BestPawn = NULL;
-
-	for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
-	{
-		if (TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-		{
-			const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-			if (DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPawn = TestPawn;
-			}
-		}
-	}
-
+	AShooterCharacter* BestPawn = CharacterGrid->FindNearestEnemy(this, MyBot->GetActorLocation());
 	if (BestPawn)
 	{
 		SetEnemy(BestPawn);
@@ -99,27 +89,17 @@ bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEne
 {
 	bool bGotEnemy = false;
 	APawn* MyBot = GetPawn();
-	if (MyBot != NULL)
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (MyBot != NULL && CharacterGrid != NULL)
 	{
-		const FVector MyLoc = MyBot->GetActorLocation();
-		float BestDistSq = MAX_FLT;
-		AShooterCharacter* BestPawn = NULL;
-
-		for (AShooterCharacter* TestPawn : TActorRange<AShooterCharacter>(GetWorld()))
+		// candidates come nearest first, so the first one we can see is the closest one we can see.
+		// the nearest ones are traced right away if they were never traced, the others only count once their async trace is back
+		int32 NumSyncCandidates = MaxSyncLOSCandidates;
+		AShooterCharacter* BestPawn = CharacterGrid->FindNearestEnemy(this, MyBot->GetActorLocation(), [this, ExcludeEnemy, &NumSyncCandidates](AShooterCharacter* TestPawn)
 		{
-			if (TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-			{
-				if (HasWeaponLOSToEnemy(TestPawn, true) == true)
-				{
-					const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-					if (DistSq < BestDistSq)
-					{
-						BestDistSq = DistSq;
-						BestPawn = TestPawn;
-					}
-				}
-			}
-		}
+			return TestPawn != ExcludeEnemy && HasWeaponLOSToEnemy(TestPawn, true, NumSyncCandidates-- > 0);
+		});
+
 		if (BestPawn)
 		{
 			SetEnemy(BestPawn);
@@ -129,27 +109,17 @@ bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEne
 	return bGotEnemy;
 }
 
-bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const
+bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy, const bool bTraceNowIfUnknown) const
 {
-	
-	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
+	UShooterBotPerception* Perception = UShooterBotPerception::Get(this);
 
 	bool bHasLOS = false;
-	// Perform trace to retrieve hit info
-	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AIWeaponLosTrace), true, GetPawn());
-
-	TraceParams.bReturnPhysicalMaterial = true;	
-	FVector StartLocation = MyBot->GetActorLocation();	
-	StartLocation.Z += GetPawn()->BaseEyeHeight; //look from eyes
-	
-	FHitResult Hit(ForceInit);
-	const FVector EndLocation = InEnemyActor->GetActorLocation();
-	GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-	if (Hit.bBlockingHit == true)
+	FShooterLOSResult Hit;
+	if (Perception && Perception->GetLOSResult(GetPawn(), InEnemyActor, InEnemyActor->GetActorLocation(), Hit, bTraceNowIfUnknown) && Hit.bBlockingHit == true)
 	{
 		// Theres a blocking hit - check if its our enemy actor
-		AActor* HitActor = Hit.GetActor();
-		if (Hit.GetActor() != NULL)
+		AActor* HitActor = Hit.HitActor;
+		if (HitActor != NULL)
 		{
 			if (HitActor == InEnemyActor)
 			{
@@ -175,8 +145,6 @@ bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool
 		}
 	}
 
-	
-
 	return bHasLOS;
 }
 
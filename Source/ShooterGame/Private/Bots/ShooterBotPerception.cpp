@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBotPerception.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS Cache Hits"), STAT_ShooterBotLOSCacheHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS Cache Misses"), STAT_ShooterBotLOSCacheMisses, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS Traces"), STAT_ShooterBotLOSTraces, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bot LOS Sync Traces"), STAT_ShooterBotLOSSyncTraces, STATGROUP_Shooter);
+
+static float BotLOSCacheTTL = 0.2f;
+FAutoConsoleVariableRef CVarBotLOSCacheTTL(
+	TEXT("p.BotLOSCacheTTL"),
+	BotLOSCacheTTL,
+	TEXT("How long (in seconds) a bot LOS trace result is reused before it is traced again"),
+	ECVF_Default);
+
+/** target locations closer than this share their cache entry */
+static const float LOSTargetCellSize = 50.f;
+
+/** traces that didn't come back after this long are considered lost and resubmitted */
+static const float LOSTraceTimeout = 1.f;
+
+/** entries nobody asked for during this long are dropped */
+static const float LOSEntryLifetime = 2.f;
+
+UShooterBotPerception* UShooterBotPerception::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UShooterBotPerception>() : nullptr;
+}
+
+bool UShooterBotPerception::GetLOSResult(APawn* Viewer, AActor* Target, const FVector& TargetLocation, FShooterLOSResult& OutResult, bool bTraceNowIfUnknown)
+{
+	if (Viewer == nullptr)
+	{
+		return false;
+	}
+
+	ConditionalPrune();
+
+	FLOSKey Key;
+	Key.Viewer = Viewer;
+	Key.Target = Target;
+	Key.TargetCell = Target ? FIntVector::ZeroValue : FIntVector(TargetLocation / LOSTargetCellSize);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	FLOSEntry& Entry = Cache.FindOrAdd(Key);
+	Entry.RequestTime = Now;
+
+	const FVector StartLocation = Viewer->GetActorLocation() + FVector(0.f, 0.f, Viewer->BaseEyeHeight); //look from eyes
+	const FVector EndLocation = Target ? Target->GetActorLocation() : TargetLocation;
+	const FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(AIWeaponLosTrace), true, Viewer);
+
+	if (Entry.bHasResult && Now - Entry.ResultTime <= BotLOSCacheTTL)
+	{
+		INC_DWORD_STAT(STAT_ShooterBotLOSCacheHits);
+	}
+	else if (!Entry.bHasResult && bTraceNowIfUnknown)
+	{
+		// nothing to fall back on and the caller can't wait, a trace still in flight is simply superseded
+		INC_DWORD_STAT(STAT_ShooterBotLOSCacheMisses);
+		INC_DWORD_STAT(STAT_ShooterBotLOSSyncTraces);
+
+		FHitResult Hit;
+		GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
+		StoreResult(Entry, &Hit, StartLocation, EndLocation);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ShooterBotLOSCacheMisses);
+
+		if (Entry.PendingTraceId != 0 && Now - Entry.SubmitTime > LOSTraceTimeout)
+		{
+			PendingTraces.Remove(Entry.PendingTraceId);
+			Entry.PendingTraceId = 0;
+		}
+
+		// the first request of the pair this frame submits the trace, the others wait for its result
+		if (Entry.PendingTraceId == 0)
+		{
+			if (!TraceDelegate.IsBound())
+			{
+				TraceDelegate.BindUObject(this, &UShooterBotPerception::OnTraceDone);
+			}
+
+			LastTraceId = FMath::Max(LastTraceId + 1, 1u);
+			Entry.PendingTraceId = LastTraceId;
+			Entry.SubmitTime = Now;
+			PendingTraces.Add(LastTraceId, Key);
+
+			GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, LastTraceId);
+
+			INC_DWORD_STAT(STAT_ShooterBotLOSTraces);
+		}
+	}
+
+	if (!Entry.bHasResult)
+	{
+		return false;
+	}
+
+	OutResult.bBlockingHit = Entry.bBlockingHit;
+	OutResult.HitActor = Entry.HitActor.Get();
+	OutResult.HitDistSq = Entry.HitDistSq;
+	OutResult.TargetDistSq = Entry.TargetDistSq;
+	return true;
+}
+
+void UShooterBotPerception::OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FLOSKey Key;
+	if (!PendingTraces.RemoveAndCopyValue(Datum.UserData, Key))
+	{
+		// timed out and resubmitted, or pruned
+		return;
+	}
+
+	FLOSEntry* Entry = Cache.Find(Key);
+	if (Entry == nullptr || Entry->PendingTraceId != Datum.UserData)
+	{
+		return;
+	}
+
+	Entry->PendingTraceId = 0;
+	StoreResult(*Entry, Datum.OutHits.Num() > 0 ? &Datum.OutHits[0] : nullptr, Datum.Start, Datum.End);
+}
+
+void UShooterBotPerception::StoreResult(FLOSEntry& Entry, const FHitResult* Hit, const FVector& Start, const FVector& End)
+{
+	Entry.ResultTime = GetWorld()->GetTimeSeconds();
+	Entry.bHasResult = true;
+	Entry.bBlockingHit = Hit && Hit->bBlockingHit;
+	Entry.HitActor = Entry.bBlockingHit ? Hit->GetActor() : nullptr;
+	Entry.HitDistSq = Entry.bBlockingHit ? (Hit->ImpactPoint - Start).SizeSquared() : 0.f;
+	Entry.TargetDistSq = (End - Start).SizeSquared();
+}
+
+void UShooterBotPerception::ConditionalPrune()
+{
+	if (LastPruneFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastPruneFrame = GFrameCounter;
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	for (auto It = Cache.CreateIterator(); It; ++It)
+	{
+		const FLOSEntry& Entry = It.Value();
+		if (!It.Key().Viewer.IsValid() || Now - Entry.RequestTime > LOSEntryLifetime)
+		{
+			if (Entry.PendingTraceId != 0)
+			{
+				PendingTraces.Remove(Entry.PendingTraceId);
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UShooterBotPerception::Deinitialize()
+{
+	Cache.Empty();
+	PendingTraces.Empty();
+	TraceDelegate.Unbind();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,209 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterCharacterGrid.h"
+#include "Online/ShooterPlayerState.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Grid Rebuild"), STAT_ShooterCharacterGridRebuild, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Character Grid Query"), STAT_ShooterCharacterGridQuery, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Character Grid Candidates Tested"), STAT_ShooterCharacterGridCandidates, STATGROUP_Shooter);
+
+static float CharacterGridCellSize = 2500.f;
+FAutoConsoleVariableRef CVarCharacterGridCellSize(
+	TEXT("p.CharacterGridCellSize"),
+	CharacterGridCellSize,
+	TEXT("Size of the cells of the grid bots use to find their closest enemies"),
+	ECVF_Default);
+
+UShooterCharacterGrid* UShooterCharacterGrid::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UShooterCharacterGrid>() : nullptr;
+}
+
+AShooterCharacter* UShooterCharacterGrid::FindNearestEnemy(AController* Querier, const FVector& Origin)
+{
+	return FindNearestEnemy(Querier, Origin, [](AShooterCharacter*) { return true; });
+}
+
+AShooterCharacter* UShooterCharacterGrid::FindNearestEnemy(AController* Querier, const FVector& Origin, TFunctionRef<bool(AShooterCharacter*)> Predicate)
+{
+	ConditionalRebuild();
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterGridQuery);
+
+	if (Querier == nullptr || Entries.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const AShooterPlayerState* QuerierPlayerState = Cast<AShooterPlayerState>(Querier->PlayerState);
+	const int32 QuerierTeam = (bTeamGame && QuerierPlayerState) ? QuerierPlayerState->GetTeamNum() : INDEX_NONE;
+
+	struct FCandidate
+	{
+		float DistSq;
+		int32 Index;
+	};
+	auto CandidateLess = [](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; };
+
+	// candidates found so far, a heap ordered by distance
+	TArray<FCandidate, TInlineAllocator<32>> Pending;
+
+	const FIntPoint Center = GetCell(Origin);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(MinCell.X - Center.X), FMath::Abs(MaxCell.X - Center.X)),
+		FMath::Max(FMath::Abs(MinCell.Y - Center.Y), FMath::Abs(MaxCell.Y - Center.Y)));
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		// gather the cells on the border of the square, the inside was done by the previous rings
+		for (int32 Y = Center.Y - Ring; Y <= Center.Y + Ring; Y++)
+		{
+			const bool bEdgeRow = FMath::Abs(Y - Center.Y) == Ring;
+			const int32 XStep = bEdgeRow ? 1 : 2 * Ring;
+			for (int32 X = Center.X - Ring; X <= Center.X + Ring; X += XStep)
+			{
+				const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+				if (Cell == nullptr)
+				{
+					continue;
+				}
+
+				for (const int32 Index : *Cell)
+				{
+					const FEntry& Entry = Entries[Index];
+					if (QuerierTeam != INDEX_NONE && Entry.TeamNum == QuerierTeam)
+					{
+						continue;
+					}
+
+					// may have died or been destroyed since the rebuild earlier this frame
+					if (IsValid(Entry.Character) && Entry.Character->IsAlive() && Entry.Character->IsEnemyFor(Querier))
+					{
+						Pending.HeapPush({ FVector::DistSquared(Entry.Location, Origin), Index }, CandidateLess);
+					}
+				}
+			}
+		}
+
+		// everything within Ring cells of the center has been gathered, so candidates closer than that are final
+		const float SafeDistSq = FMath::Square(Ring * CellSize);
+		while (Pending.Num() > 0 && (Pending.HeapTop().DistSq <= SafeDistSq || Ring == MaxRing))
+		{
+			FCandidate Candidate;
+			Pending.HeapPop(Candidate, CandidateLess, false);
+
+			INC_DWORD_STAT(STAT_ShooterCharacterGridCandidates);
+			AShooterCharacter* Character = Entries[Candidate.Index].Character;
+			if (Predicate(Character))
+			{
+				return Character;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void UShooterCharacterGrid::ForEachCharacterInRadius(const FVector& Origin, float Radius, TFunctionRef<void(AShooterCharacter*)> Visitor)
+{
+	ConditionalRebuild();
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterGridQuery);
+
+	const FIntPoint MinQueryCell = GetCell(Origin - FVector(Radius));
+	const FIntPoint MaxQueryCell = GetCell(Origin + FVector(Radius));
+	const float RadiusSq = FMath::Square(Radius);
+
+	for (int32 Y = MinQueryCell.Y; Y <= MaxQueryCell.Y; Y++)
+	{
+		for (int32 X = MinQueryCell.X; X <= MaxQueryCell.X; X++)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (Cell == nullptr)
+			{
+				continue;
+			}
+
+			for (const int32 Index : *Cell)
+			{
+				const FEntry& Entry = Entries[Index];
+				if (IsValid(Entry.Character) && FVector::DistSquared2D(Entry.Location, Origin) <= RadiusSq)
+				{
+					Visitor(Entry.Character);
+				}
+			}
+		}
+	}
+}
+
+void UShooterCharacterGrid::ConditionalRebuild()
+{
+	if (LastRebuildFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastRebuildFrame = GFrameCounter;
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterGridRebuild);
+
+	// keep the cell arrays around, bots mostly stay in the same cells from frame to frame
+	const float NewCellSize = FMath::Max(CharacterGridCellSize, 100.f);
+	if (NewCellSize != CellSize || Cells.Num() > 4 * Entries.Num() + 64)
+	{
+		Cells.Reset();
+		CellSize = NewCellSize;
+	}
+	for (auto& It : Cells)
+	{
+		It.Value.Reset();
+	}
+	Entries.Reset();
+
+	const AShooterGameState* const GameState = GetWorld()->GetGameState<AShooterGameState>();
+	bTeamGame = GameState && GameState->NumTeams > 1;
+
+	MinCell = FIntPoint(MAX_int32, MAX_int32);
+	MaxCell = FIntPoint(MIN_int32, MIN_int32);
+
+	// dead characters are kept, their bodies still block spawnpoints
+	for (AShooterCharacter* Character : TActorRange<AShooterCharacter>(GetWorld()))
+	{
+		if (Character->IsPendingKill())
+		{
+			continue;
+		}
+
+		AddEntry(Character);
+	}
+}
+
+void UShooterCharacterGrid::AddCharacter(AShooterCharacter* Character)
+{
+	// otherwise the next rebuild picks it up
+	if (Character && LastRebuildFrame == GFrameCounter)
+	{
+		AddEntry(Character);
+	}
+}
+
+void UShooterCharacterGrid::AddEntry(AShooterCharacter* Character)
+{
+	const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Character->GetPlayerState());
+	const FVector Location = Character->GetActorLocation();
+	const FIntPoint Cell = GetCell(Location);
+
+	const int32 Index = Entries.Add({ Character, Location, PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE });
+	Cells.FindOrAdd(Cell).Add(Index);
+
+	MinCell.X = FMath::Min(MinCell.X, Cell.X);
+	MinCell.Y = FMath::Min(MinCell.Y, Cell.Y);
+	MaxCell.X = FMath::Max(MaxCell.X, Cell.X);
+	MaxCell.Y = FMath::Max(MaxCell.Y, Cell.Y);
+}
+
+FIntPoint UShooterCharacterGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
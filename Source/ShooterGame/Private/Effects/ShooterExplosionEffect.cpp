@@ -19,11 +19,12 @@ AShooterExplosionEffect::AShooterExplosionEffect(const FObjectInitializer& Objec
 	ExplosionLight->SetVisibleFlag(true);
 
 	ExplosionLightFadeOut = 0.2f;
+	ExplosionStartTime = 0.0f;
 }
 
-void AShooterExplosionEffect::BeginPlay()
+void AShooterExplosionEffect::OnAcquiredFromPool()
 {
-	Super::BeginPlay();
+	ExplosionStartTime = GetWorld()->GetTimeSeconds();
 
 	if (ExplosionFX)
 	{
@@ -51,7 +52,7 @@ void AShooterExplosionEffect::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	const float TimeAlive = GetWorld()->GetTimeSeconds() - CreationTime;
+	const float TimeAlive = GetWorld()->GetTimeSeconds() - ExplosionStartTime;
 	const float TimeRemaining = FMath::Max(0.0f, ExplosionLightFadeOut - TimeAlive);
 
 	if (TimeRemaining > 0)
@@ -63,6 +64,6 @@ void AShooterExplosionEffect::Tick(float DeltaSeconds)
 	}
 	else
 	{
-		Destroy();
+		UShooterActorPool::ReleaseOrDestroy(this);
 	}
 }
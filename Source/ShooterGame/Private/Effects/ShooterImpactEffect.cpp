@@ -5,13 +5,10 @@
 
 AShooterImpactEffect::AShooterImpactEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
-	SetAutoDestroyWhenFinished(true);
 }
 
-void AShooterImpactEffect::PostInitializeComponents()
+void AShooterImpactEffect::OnAcquiredFromPool()
 {
-	Super::PostInitializeComponents();
-
 	UPhysicalMaterial* HitPhysMat = SurfaceHit.PhysMaterial.Get();
 	EPhysicalSurface HitSurfaceType = UPhysicalMaterial::DetermineSurfaceType(HitPhysMat);
 
@@ -39,6 +36,13 @@ void AShooterImpactEffect::PostInitializeComponents()
 			SurfaceHit.ImpactPoint, RandomDecalRotation, EAttachLocation::KeepWorldPosition,
 			DefaultDecal.LifeSpan);
 	}
+
+	GetWorldTimerManager().SetTimerForNextTick(this, &AShooterImpactEffect::ReleaseToPool);
+}
+
+void AShooterImpactEffect::ReleaseToPool()
+{
+	UShooterActorPool::ReleaseOrDestroy(this);
 }
 
 UParticleSystem* AShooterImpactEffect::GetImpactFX(TEnumAsByte<EPhysicalSurface> SurfaceType) const
@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterDemoNetDriver.h"
+#include "NetworkReplayStreaming.h"
+
+DECLARE_CYCLE_STAT(TEXT("Replay Record (game thread)"), STAT_ShooterReplayRecord, STATGROUP_Shooter);
+DECLARE_MEMORY_STAT(TEXT("Replay Buffered Data"), STAT_ShooterReplayBufferedMemory, STATGROUP_Shooter);
+
+UShooterDemoNetDriver::UShooterDemoNetDriver(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	LocalCheckpointUploadDelayInSeconds = 10.0f;
+}
+
+bool UShooterDemoNetDriver::InitListen(FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error)
+{
+	// a dedicated server records every match, so it keeps the cheaper default checkpoint interval
+	UWorld* const World = GetWorld();
+	if (World && World->GetNetMode() != NM_DedicatedServer && LocalCheckpointUploadDelayInSeconds > 0.0f)
+	{
+		IConsoleVariable* CheckpointDelayCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds"));
+		if (CheckpointDelayCVar)
+		{
+			PreviousCheckpointUploadDelay = CheckpointDelayCVar->GetFloat();
+			CheckpointDelayCVar->Set(LocalCheckpointUploadDelayInSeconds, ECVF_SetByCode);
+		}
+	}
+
+	return Super::InitListen(InNotify, ListenURL, bReuseAddressAndPort, Error);
+}
+
+void UShooterDemoNetDriver::TickFlush(float DeltaSeconds)
+{
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ShooterReplayRecord);
+		Super::TickFlush(DeltaSeconds);
+	}
+
+	if (!IsRecording() || !ReplayStreamer.IsValid())
+	{
+		return;
+	}
+
+	// the streamer empties its stream archive every time it hands a chunk to its file tasks
+	FArchive* StreamAr = ReplayStreamer->GetStreamingArchive();
+	SET_MEMORY_STAT(STAT_ShooterReplayBufferedMemory, StreamAr ? StreamAr->TotalSize() : 0);
+}
+
+void UShooterDemoNetDriver::Shutdown()
+{
+	// a later recording in this process, a dedicated server one included, starts from the previous interval
+	if (PreviousCheckpointUploadDelay.IsSet())
+	{
+		if (IConsoleVariable* CheckpointDelayCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds")))
+		{
+			CheckpointDelayCVar->Set(PreviousCheckpointUploadDelay.GetValue(), ECVF_SetByCode);
+		}
+		PreviousCheckpointUploadDelay.Reset();
+	}
+
+	Super::Shutdown();
+}
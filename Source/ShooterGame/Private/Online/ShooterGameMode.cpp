@@ -8,7 +8,9 @@
 #include "Online/ShooterGameMode.h"
 #include "Online/ShooterPlayerState.h"
 #include "Online/ShooterGameSession.h"
+#include "Online/ShooterReplayEvents.h"
 #include "Bots/ShooterAIController.h"
+#include "Bots/ShooterCharacterGrid.h"
 #include "ShooterTeamStart.h"
 
 
@@ -28,6 +30,10 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 	ReplaySpectatorPlayerControllerClass = AShooterDemoSpectator::StaticClass();
 
 	MinRespawnDelay = 5.0f;
+	SpawnEnemyAvoidRadius = 2500.0f;
+	SpawnSightCheckCandidates = 3;
+	bPlayerStartsDirty = false;
+	bRecordDedicatedServerReplays = false;
 
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
@@ -54,6 +60,10 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	SetAllowBots(BotsCountOptionValue > 0 ? true : false, BotsCountOptionValue);	
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	CachePlayerStarts();
+	FWorldDelegates::LevelAddedToWorld.AddUObject(this, &AShooterGameMode::OnLevelAddedOrRemoved);
+	FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &AShooterGameMode::OnLevelAddedOrRemoved);
+
 	const UGameInstance* GameInstance = GetGameInstance();
 	if (GameInstance && Cast<UShooterGameInstance>(GameInstance)->GetOnlineMode() != EOnlineMode::Offline)
 	{
@@ -73,6 +83,14 @@ TSubclassOf<AGameSession> AShooterGameMode::GetGameSessionClass() const
 	return AShooterGameSession::StaticClass();
 }
 
+void AShooterGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+	FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AShooterGameMode::PreInitializeComponents()
 {
 	Super::PreInitializeComponents();
@@ -168,6 +186,13 @@ void AShooterGameMode::HandleMatchHasStarted()
 	MyGameState->RemainingTime = RoundTime;	
 	StartBots();	
 
+	// listen servers record with ?DemoRec from the menu, dedicated servers from config
+	if (bRecordDedicatedServerReplays && GetNetMode() == NM_DedicatedServer && GetGameInstance())
+	{
+		const FString ReplayName = FString::Printf(TEXT("%s-%s"), *UWorld::RemovePIEPrefix(GetWorld()->GetMapName()), *FDateTime::UtcNow().ToString());
+		GetGameInstance()->StartRecordingReplay(ReplayName, ReplayName);
+	}
+
 	// notify players
 	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 	{
@@ -179,6 +204,13 @@ void AShooterGameMode::HandleMatchHasStarted()
 	}
 }
 
+void AShooterGameMode::OnMatchStateSet()
+{
+	Super::OnMatchStateSet();
+
+	ShooterReplayEvents::Record(GetWorld(), ShooterReplayEvents::MatchStateGroup, MatchState.ToString());
+}
+
 void AShooterGameMode::HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer)
 {
 	Super::HandleStartingNewPlayer_Implementation(NewPlayer);
@@ -192,6 +224,11 @@ void AShooterGameMode::FinishMatch()
 		EndMatch();
 		DetermineMatchWinner();		
 
+		if (bRecordDedicatedServerReplays && GetNetMode() == NM_DedicatedServer && GetGameInstance())
+		{
+			GetGameInstance()->StopRecordingReplay();
+		}
+
 		// notify players
 		for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 		{
@@ -313,6 +350,9 @@ void AShooterGameMode::Killed(AController* Killer, AController* KilledPlayer, AP
 		VictimPlayerState->ScoreDeath(KillerPlayerState, DeathScore);
 		VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
 	}
+
+	const FString KillMeta = FString::Printf(TEXT("%s\t%s"), KillerPlayerState ? *KillerPlayerState->GetShortPlayerName() : TEXT(""), VictimPlayerState ? *VictimPlayerState->GetShortPlayerName() : TEXT(""));
+	ShooterReplayEvents::Record(GetWorld(), ShooterReplayEvents::KillGroup, KillMeta);
 }
 
 float AShooterGameMode::ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const
@@ -370,6 +410,13 @@ void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 {
 	Super::RestartPlayer(NewPlayer);
 
+	// let spawns later in this frame's respawn wave know about the new pawn
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (CharacterGrid && NewPlayer)
+	{
+		CharacterGrid->AddCharacter(Cast<AShooterCharacter>(NewPlayer->GetPawn()));
+	}
+
 	AShooterPlayerController* PC = Cast<AShooterPlayerController>(NewPlayer);
 	if (PC)
 	{
@@ -384,47 +431,96 @@ void AShooterGameMode::RestartPlayer(AController* NewPlayer)
 	}
 }
 
-AActor* AShooterGameMode::ChoosePlayerStart_Implementation(AController* Player)
+void AShooterGameMode::CachePlayerStarts()
 {
-	TArray<APlayerStart*> PreferredSpawns;
-	TArray<APlayerStart*> FallbackSpawns;
-
-	APlayerStart* BestStart = NULL;
+	bPlayerStartsDirty = false;
+	CachedPlayerStarts.Reset();
 	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
 	{
-		APlayerStart* TestSpawn = *It;
-		if (TestSpawn->IsA<APlayerStartPIE>())
+		if (!It->IsA<APlayerStartPIE>())
 		{
-			// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
-			BestStart = TestSpawn;
-			break;
+			CachedPlayerStarts.Add(*It);
 		}
-		else
+	}
+}
+
+void AShooterGameMode::OnLevelAddedOrRemoved(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		bPlayerStartsDirty = true;
+	}
+}
+
+AActor* AShooterGameMode::ChoosePlayerStart_Implementation(AController* Player)
+{
+	if (GetWorld()->IsPlayInEditor())
+	{
+		// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
+		TActorIterator<APlayerStartPIE> It(GetWorld());
+		if (It)
 		{
-			if (IsSpawnpointAllowed(TestSpawn, Player))
-			{
-				if (IsSpawnpointPreferred(TestSpawn, Player))
-				{
-					PreferredSpawns.Add(TestSpawn);
-				}
-				else
-				{
-					FallbackSpawns.Add(TestSpawn);
-				}
-			}
+			return *It;
 		}
 	}
 
-	
-	if (BestStart == NULL)
+	// levels streamed in or out since the last spawn bring or take away player starts
+	if (bPlayerStartsDirty)
+	{
+		CachePlayerStarts();
+	}
+	else
 	{
-		if (PreferredSpawns.Num() > 0)
+		CachedPlayerStarts.RemoveAll([](APlayerStart* SpawnPoint) { return !IsValid(SpawnPoint); });
+	}
+
+	struct FSpawnCandidate
+	{
+		APlayerStart* SpawnPoint;
+		float Danger;
+
+		/** keeps equally safe spawnpoints from always being picked in the same order */
+		float Jitter;
+	};
+
+	TArray<FSpawnCandidate, TInlineAllocator<32>> PreferredSpawns;
+	TArray<FSpawnCandidate, TInlineAllocator<32>> FallbackSpawns;
+
+	for (APlayerStart* TestSpawn : CachedPlayerStarts)
+	{
+		if (IsSpawnpointAllowed(TestSpawn, Player))
 		{
-			BestStart = PreferredSpawns[FMath::RandHelper(PreferredSpawns.Num())];
+			const FSpawnCandidate Candidate = { TestSpawn, RateSpawnpointDanger(TestSpawn, Player, false), FMath::FRand() * 0.1f };
+			if (IsSpawnpointPreferred(TestSpawn, Player))
+			{
+				PreferredSpawns.Add(Candidate);
+			}
+			else
+			{
+				FallbackSpawns.Add(Candidate);
+			}
 		}
-		else if (FallbackSpawns.Num() > 0)
+	}
+
+	TArray<FSpawnCandidate, TInlineAllocator<32>>& Candidates = PreferredSpawns.Num() > 0 ? PreferredSpawns : FallbackSpawns;
+
+	APlayerStart* BestStart = NULL;
+	if (Candidates.Num() > 0)
+	{
+		Candidates.Sort([](const FSpawnCandidate& A, const FSpawnCandidate& B) { return A.Danger + A.Jitter < B.Danger + B.Jitter; });
+		BestStart = Candidates[0].SpawnPoint;
+
+		// sight lines need traces, only check them for the safest few
+		const int32 NumSightChecks = FMath::Min(Candidates.Num(), SpawnSightCheckCandidates);
+		float BestDanger = MAX_FLT;
+		for (int32 i = 0; i < NumSightChecks; i++)
 		{
-			BestStart = FallbackSpawns[FMath::RandHelper(FallbackSpawns.Num())];
+			const float Danger = RateSpawnpointDanger(Candidates[i].SpawnPoint, Player, true) + Candidates[i].Jitter;
+			if (Danger < BestDanger)
+			{
+				BestDanger = Danger;
+				BestStart = Candidates[i].SpawnPoint;
+			}
 		}
 	}
 
@@ -461,31 +557,67 @@ bool AShooterGameMode::IsSpawnpointPreferred(APlayerStart* SpawnPoint, AControll
 		MyPawn = Cast<ACharacter>(BotPawnClass->GetDefaultObject<ACharacter>());
 	}
 	
-	if (MyPawn)
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (MyPawn && CharacterGrid)
 	{
 		const FVector SpawnLocation = SpawnPoint->GetActorLocation();
-		for (ACharacter* OtherPawn : TActorRange<ACharacter>(GetWorld()))
+		const float MyRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		const float MyHalfHeight = MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+		// all characters share about the same capsule, leave room for bigger ones
+		bool bOverlapsPawn = false;
+		CharacterGrid->ForEachCharacterInRadius(SpawnLocation, MyRadius * 4.0f, [&](AShooterCharacter* OtherPawn)
 		{
-			if (OtherPawn != MyPawn)
-			{
-				const float CombinedHeight = (MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
-				const float CombinedRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
-				const FVector OtherLocation = OtherPawn->GetActorLocation();
+			const float CombinedHeight = (MyHalfHeight + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
+			const float CombinedRadius = MyRadius + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
+			const FVector OtherLocation = OtherPawn->GetActorLocation();
 
-				// check if player start overlaps this pawn
-				if (FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius)
-				{
-					return false;
-				}
+			// check if player start overlaps this pawn
+			if (FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius)
+			{
+				bOverlapsPawn = true;
 			}
-		}
+		});
+
+		return !bOverlapsPawn;
 	}
 	else
 	{
 		return false;
 	}
-	
-	return true;
+}
+
+float AShooterGameMode::RateSpawnpointDanger(APlayerStart* SpawnPoint, AController* Player, bool bCheckSightLines) const
+{
+	UShooterCharacterGrid* CharacterGrid = UShooterCharacterGrid::Get(this);
+	if (CharacterGrid == NULL || Player == NULL || SpawnEnemyAvoidRadius <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	const FVector SpawnLocation = SpawnPoint->GetActorLocation();
+	float Danger = 0.0f;
+
+	CharacterGrid->ForEachCharacterInRadius(SpawnLocation, SpawnEnemyAvoidRadius, [&](AShooterCharacter* OtherPawn)
+	{
+		if (OtherPawn->IsAlive() && OtherPawn->IsEnemyFor(Player))
+		{
+			// closer enemies count more
+			Danger += 1.0f - (OtherPawn->GetActorLocation() - SpawnLocation).Size2D() / SpawnEnemyAvoidRadius;
+
+			// an enemy that can see the spawnpoint counts as much as one standing on it
+			if (bCheckSightLines)
+			{
+				const FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(SpawnSightTrace), false, OtherPawn);
+				if (!GetWorld()->LineTraceTestByChannel(OtherPawn->GetPawnViewLocation(), SpawnLocation, ECC_Visibility, TraceParams))
+				{
+					Danger += 1.0f;
+				}
+			}
+		}
+	});
+
+	return Danger;
 }
 
 void AShooterGameMode::CreateBotControllers()
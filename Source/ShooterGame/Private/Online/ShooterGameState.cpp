@@ -5,6 +5,15 @@
 #include "ShooterGameInstance.h"
 #include "OnlineSubsystemUtils.h"
 #include "OnlineGameMatchesInterface.h"
+#include "ShooterActorPool.h"
+#include "Pickups/ShooterPickup_Weapon.h"
+
+static int32 ActorPoolPrewarmCount = 8;
+FAutoConsoleVariableRef CVarActorPoolPrewarmCount(
+	TEXT("p.ActorPoolPrewarmCount"),
+	ActorPoolPrewarmCount,
+	TEXT("How many actors of each pooled projectile and effect class are spawned when the match starts."),
+	ECVF_Default);
 
 AShooterGameState::AShooterGameState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -27,36 +36,76 @@ void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	DOREPLIFETIME( AShooterGameState, TeamScores );
 }
 
-void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
+const RankedPlayerList& AShooterGameState::GetRankedPlayers(int32 TeamIndex) const
 {
-	OutRankedMap.Empty();
+	ConditionalRebuildRanking();
+
+	static const RankedPlayerList NoPlayers;
+	return RankedPlayers.IsValidIndex(TeamIndex) ? RankedPlayers[TeamIndex] : NoPlayers;
+}
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+int32 AShooterGameState::GetPlayerRank(const AShooterPlayerState* PlayerState) const
+{
+	return PlayerState ? GetRankedPlayers(PlayerState->GetTeamNum()).IndexOfByKey(PlayerState) : INDEX_NONE;
+}
+
+void AShooterGameState::InvalidateRanking()
+{
+	bRankingDirty = true;
+	RankingVersion++;
+}
+
+void AShooterGameState::ConditionalRebuildRanking() const
+{
+	if (!bRankingDirty)
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
-		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->GetScore()), CurPlayerState);
-		}
+		return;
 	}
+	bRankingDirty = false;
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+	// keep the team arrays, the ranking changes with every kill but the number of players rarely does
+	for (RankedPlayerList& TeamPlayers : RankedPlayers)
+	{
+		TeamPlayers.Reset();
+	}
 
-	//now, add them back to the ranked map
-	OutRankedMap.Empty();
+	for (APlayerState* PlayerState : PlayerArray)
+	{
+		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerState);
+		const int32 TeamIndex = CurPlayerState ? CurPlayerState->GetTeamNum() : INDEX_NONE;
+		if (TeamIndex >= 0)
+		{
+			if (TeamIndex >= RankedPlayers.Num())
+			{
+				RankedPlayers.SetNum(TeamIndex + 1);
+			}
+			RankedPlayers[TeamIndex].Add(CurPlayerState);
+		}
+	}
 
-	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+	// ties are broken by player id so the order doesn't flicker between rebuilds
+	for (RankedPlayerList& TeamPlayers : RankedPlayers)
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		TeamPlayers.Sort([](const TWeakObjectPtr<AShooterPlayerState>& A, const TWeakObjectPtr<AShooterPlayerState>& B)
+		{
+			const int32 ScoreA = FMath::TruncToInt(A->GetScore());
+			const int32 ScoreB = FMath::TruncToInt(B->GetScore());
+			return ScoreA != ScoreB ? ScoreA > ScoreB : A->GetPlayerId() < B->GetPlayerId();
+		});
 	}
-	
 }
 
+void AShooterGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+	InvalidateRanking();
+}
+
+void AShooterGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	Super::RemovePlayerState(PlayerState);
+	InvalidateRanking();
+}
 
 void AShooterGameState::RequestFinishAndExitToMainMenu()
 {
@@ -90,6 +139,55 @@ void AShooterGameState::HandleMatchHasStarted()
 {
 	Super::HandleMatchHasStarted();
 	GameMatches.HandleMatchHasStarted(ActivityId, NumTeams);
+
+	PrewarmActorPool();
+}
+
+void AShooterGameState::PrewarmActorPool()
+{
+	UShooterActorPool* Pool = UShooterActorPool::Get(this);
+	if (Pool == nullptr || ActorPoolPrewarmCount <= 0)
+	{
+		return;
+	}
+
+	// weapons players spawn with, plus any that can be picked up in this level
+	TArray<TSubclassOf<AShooterWeapon>, TInlineAllocator<8>> WeaponClasses;
+
+	const AGameModeBase* DefaultGameMode = GetDefaultGameMode();
+	const AShooterCharacter* DefaultPawn = (DefaultGameMode && DefaultGameMode->DefaultPawnClass) ? Cast<AShooterCharacter>(DefaultGameMode->DefaultPawnClass->GetDefaultObject()) : nullptr;
+	if (DefaultPawn)
+	{
+		for (const TSubclassOf<AShooterWeapon>& WeaponClass : DefaultPawn->GetDefaultInventoryClasses())
+		{
+			WeaponClasses.AddUnique(WeaponClass);
+		}
+	}
+
+	for (TActorIterator<AShooterPickup_Weapon> It(GetWorld()); It; ++It)
+	{
+		WeaponClasses.AddUnique(It->GetWeaponType());
+	}
+
+	TArray<UClass*> PooledClasses;
+	for (const TSubclassOf<AShooterWeapon>& WeaponClass : WeaponClasses)
+	{
+		if (WeaponClass)
+		{
+			WeaponClass->GetDefaultObject<AShooterWeapon>()->GetPooledActorClasses(PooledClasses);
+		}
+	}
+
+	const ENetMode NetMode = GetNetMode();
+	for (UClass* PooledClass : PooledClasses)
+	{
+		// replicated actors (projectiles) are only spawned by the server, cosmetic ones only where they can be seen
+		const bool bReplicated = PooledClass->GetDefaultObject<AActor>()->GetIsReplicated();
+		if (bReplicated ? NetMode != NM_Client : NetMode != NM_DedicatedServer)
+		{
+			Pool->Prewarm(PooledClass, ActorPoolPrewarmCount);
+		}
+	}
 }
 
 void AShooterGameState::HandleMatchHasEnded()
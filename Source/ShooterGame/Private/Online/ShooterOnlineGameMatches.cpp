@@ -514,20 +514,14 @@ void FShooterOnlineGameMatches::HandleMatchHasEnded(const bool bEnableGameFeedba
 					UE_LOG(LogOnline, Warning, TEXT("GameState is not valid"));
 					return;
 				}
-				TArray<RankedPlayerMap> TeamRankedPlayers;
-				TeamRankedPlayers.AddZeroed(NumTeams);
 				for (int32 TeamIndex = 0; TeamIndex < NumTeams; ++TeamIndex)
 				{
-					WeakGameState->GetRankedMap(TeamIndex, TeamRankedPlayers[TeamIndex]);
-				}
-
-				for (int32 TeamIndex = 0; TeamIndex < TeamRankedPlayers.Num(); ++TeamIndex)
-				{
-
-					for (const TPair<int32, TWeakObjectPtr<AShooterPlayerState>>& RankedPlayer : TeamRankedPlayers[TeamIndex])
+					const RankedPlayerList& TeamRankedPlayers = WeakGameState->GetRankedPlayers(TeamIndex);
+					for (int32 Rank = 0; Rank < TeamRankedPlayers.Num(); ++Rank)
 					{
+						const TWeakObjectPtr<AShooterPlayerState>& RankedPlayer = TeamRankedPlayers[Rank];
 
-						FString PlayerIdString(FString::FromInt((*RankedPlayer.Value).GetPlayerId()));
+						FString PlayerIdString(FString::FromInt(RankedPlayer->GetPlayerId()));
 						const int32* NetIdIndex = PlayerIdToNetIdIndexMap.Find(PlayerIdString);
 						if (NetIdIndex == nullptr)
 						{
@@ -539,19 +533,19 @@ void FShooterOnlineGameMatches::HandleMatchHasEnded(const bool bEnableGameFeedba
 
 						FGameMatchPlayerResult PlayerResult;
 						PlayerResult.PlayerId = PlayerNetId;
-						PlayerResult.Rank = RankedPlayer.Key;
-						PlayerResult.Score = (*RankedPlayer.Value).GetScore();
+						PlayerResult.Rank = Rank;
+						PlayerResult.Score = RankedPlayer->GetScore();
 
-						int32 TeamId = (*RankedPlayer.Value).GetTeamNum();
+						int32 TeamId = RankedPlayer->GetTeamNum();
 
 						BuildPlayerGameMatchResults(PlayerNetId, TeamId, PlayerResult);
 
 						// Setup match stats for deaths and kills
-						BuildTeamPlayerGameMatchStats(PlayerNetId, TeamId, TEXT("Deaths"), FString::FromInt((*RankedPlayer.Value).GetDeaths()));
-						BuildTeamPlayerGameMatchStats(PlayerNetId, TeamId, TEXT("Kills"), FString::FromInt((*RankedPlayer.Value).GetKills()));
+						BuildTeamPlayerGameMatchStats(PlayerNetId, TeamId, TEXT("Deaths"), FString::FromInt(RankedPlayer->GetDeaths()));
+						BuildTeamPlayerGameMatchStats(PlayerNetId, TeamId, TEXT("Kills"), FString::FromInt(RankedPlayer->GetKills()));
 
 						// Set the match id on the player for UI access
-						(*RankedPlayer.Value).SetMatchId(MatchId);
+						RankedPlayer->SetMatchId(MatchId);
 
 					}
 				}
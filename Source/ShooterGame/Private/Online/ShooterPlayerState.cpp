@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "ShooterPlayerState.h"
+#include "Online/ShooterReplayEvents.h"
 #include "Net/OnlineEngineInterface.h"
 
 AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -9,6 +10,9 @@ AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitial
 	TeamNumber = 0;
 	NumKills = 0;
 	NumDeaths = 0;
+	NumHits = 0;
+	DamageDealt = 0.f;
+	DamageTaken = 0.f;
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
@@ -22,9 +26,14 @@ void AShooterPlayerState::Reset()
 	//SetTeamNum(0);
 	NumKills = 0;
 	NumDeaths = 0;
+	NumHits = 0;
+	DamageDealt = 0.f;
+	DamageTaken = 0.f;
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
+
+	InvalidateRanking();
 }
 
 void AShooterPlayerState::RegisterPlayerWithSession(bool bWasFromInvite)
@@ -55,11 +64,29 @@ void AShooterPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	InvalidateRanking();
 }
 
 void AShooterPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	InvalidateRanking();
+}
+
+void AShooterPlayerState::OnRep_Score()
+{
+	Super::OnRep_Score();
+
+	InvalidateRanking();
+}
+
+void AShooterPlayerState::InvalidateRanking()
+{
+	AShooterGameState* const MyGameState = GetWorld() ? GetWorld()->GetGameState<AShooterGameState>() : nullptr;
+	if (MyGameState)
+	{
+		MyGameState->InvalidateRanking();
+	}
 }
 
 void AShooterPlayerState::AddBulletsFired(int32 NumBullets)
@@ -90,6 +117,11 @@ void AShooterPlayerState::CopyProperties(APlayerState* PlayerState)
 	if (ShooterPlayer)
 	{
 		ShooterPlayer->TeamNumber = TeamNumber;
+		ShooterPlayer->NumHits = NumHits;
+		ShooterPlayer->DamageDealt = DamageDealt;
+		ShooterPlayer->DamageTaken = DamageTaken;
+		ShooterPlayer->NumBulletsFired = NumBulletsFired;
+		ShooterPlayer->NumRocketsFired = NumRocketsFired;
 	}	
 }
 
@@ -121,6 +153,21 @@ int32 AShooterPlayerState::GetDeaths() const
 	return NumDeaths;
 }
 
+int32 AShooterPlayerState::GetHits() const
+{
+	return NumHits;
+}
+
+float AShooterPlayerState::GetDamageDealt() const
+{
+	return DamageDealt;
+}
+
+float AShooterPlayerState::GetDamageTaken() const
+{
+	return DamageTaken;
+}
+
 int32 AShooterPlayerState::GetNumBulletsFired() const
 {
 	return NumBulletsFired;
@@ -153,6 +200,17 @@ void AShooterPlayerState::ScoreDeath(AShooterPlayerState* KilledBy, int32 Points
 	ScorePoints(Points);
 }
 
+void AShooterPlayerState::ScoreHit(float Damage)
+{
+	NumHits++;
+	DamageDealt += Damage;
+}
+
+void AShooterPlayerState::ScoreDamageTaken(float Damage)
+{
+	DamageTaken += Damage;
+}
+
 void AShooterPlayerState::ScorePoints(int32 Points)
 {
 	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
@@ -167,6 +225,9 @@ void AShooterPlayerState::ScorePoints(int32 Points)
 	}
 
 	SetScore(GetScore() + Points);
+	InvalidateRanking();
+
+	ShooterReplayEvents::Record(GetWorld(), ShooterReplayEvents::ScoreGroup, FString::Printf(TEXT("%s\t%d"), *GetShortPlayerName(), FMath::TruncToInt(GetScore())));
 }
 
 void AShooterPlayerState::InformAboutKill_Implementation(class AShooterPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* KilledPlayerState)
@@ -212,6 +273,11 @@ void AShooterPlayerState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty
 	DOREPLIFETIME( AShooterPlayerState, TeamNumber );
 	DOREPLIFETIME( AShooterPlayerState, NumKills );
 	DOREPLIFETIME( AShooterPlayerState, NumDeaths );
+	DOREPLIFETIME_CONDITION( AShooterPlayerState, NumHits, COND_ReplayOrOwner );
+	DOREPLIFETIME_CONDITION( AShooterPlayerState, DamageDealt, COND_ReplayOrOwner );
+	DOREPLIFETIME_CONDITION( AShooterPlayerState, DamageTaken, COND_ReplayOrOwner );
+	DOREPLIFETIME_CONDITION( AShooterPlayerState, NumBulletsFired, COND_ReplayOrOwner );
+	DOREPLIFETIME_CONDITION( AShooterPlayerState, NumRocketsFired, COND_ReplayOrOwner );
 }
 
 FString AShooterPlayerState::GetShortPlayerName() const
@@ -0,0 +1,177 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterReplayAnalyzer.h"
+#include "Online/ShooterPlayerState.h"
+#include "Engine/DemoNetDriver.h"
+
+static float ReplayAnalyzerTimeDilation = 4.f;
+FAutoConsoleVariableRef CVarReplayAnalyzerTimeDilation(
+	TEXT("p.ReplayAnalyzerTimeDilation"),
+	ReplayAnalyzerTimeDilation,
+	TEXT("Demo time played per frame of game time when analyzing a replay, higher is faster but samples less often"),
+	ECVF_Default);
+
+static float ReplayAnalyzerSampleInterval = 1.f;
+FAutoConsoleVariableRef CVarReplayAnalyzerSampleInterval(
+	TEXT("p.ReplayAnalyzerSampleInterval"),
+	ReplayAnalyzerSampleInterval,
+	TEXT("Demo time (in seconds) between two samples of the player positions when analyzing a replay"),
+	ECVF_Default);
+
+UShooterReplayAnalyzer* UShooterReplayAnalyzer::Get(const UObject* WorldContextObject)
+{
+	if (!IsAnalyzing())
+	{
+		return nullptr;
+	}
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UShooterReplayAnalyzer>() : nullptr;
+}
+
+bool UShooterReplayAnalyzer::IsAnalyzing()
+{
+	static const bool bAnalyzing = !GetReplayName().IsEmpty();
+	return bAnalyzing;
+}
+
+FString UShooterReplayAnalyzer::GetReplayName()
+{
+	FString ReplayName;
+	FParse::Value(FCommandLine::Get(), TEXT("AnalyzeReplay="), ReplayName);
+	return ReplayName;
+}
+
+bool UShooterReplayAnalyzer::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return IsAnalyzing() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UShooterReplayAnalyzer::IsTickable() const
+{
+	// the entry map has no demo driver, only the world the replay plays in
+	const UWorld* World = GetWorld();
+	return !bFinished && !IsTemplate() && World && World->GetDemoNetDriver() && World->GetDemoNetDriver()->IsPlaying();
+}
+
+TStatId UShooterReplayAnalyzer::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterReplayAnalyzer, STATGROUP_Tickables);
+}
+
+void UShooterReplayAnalyzer::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	UDemoNetDriver* DemoDriver = World->GetDemoNetDriver();
+
+	if (AWorldSettings* WorldSettings = World->GetWorldSettings())
+	{
+		WorldSettings->DemoPlayTimeDilation = ReplayAnalyzerTimeDilation;
+	}
+
+	const float DemoTime = DemoDriver->GetDemoCurrentTime();
+	if (DemoTime - LastSampleTime >= ReplayAnalyzerSampleInterval)
+	{
+		LastSampleTime = DemoTime;
+		SamplePositions(DemoTime);
+		ReadPlayerCounters();
+	}
+
+	if (DemoDriver->GetDemoTotalTime() > 0.f && DemoTime >= DemoDriver->GetDemoTotalTime())
+	{
+		Finish();
+	}
+}
+
+UShooterReplayAnalyzer::FPlayerStats* UShooterReplayAnalyzer::FindStats(const APawn* Pawn)
+{
+	return Pawn ? FindStats(Cast<AShooterPlayerState>(Pawn->GetPlayerState())) : nullptr;
+}
+
+UShooterReplayAnalyzer::FPlayerStats* UShooterReplayAnalyzer::FindStats(const AShooterPlayerState* PlayerState)
+{
+	if (PlayerState == nullptr || PlayerState->IsOnlyASpectator())
+	{
+		return nullptr;
+	}
+
+	FPlayerStats& Stats = Players.FindOrAdd(PlayerState->GetPlayerName());
+	Stats.TeamNum = PlayerState->GetTeamNum();
+	return &Stats;
+}
+
+void UShooterReplayAnalyzer::ReadPlayerCounters()
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	if (GameState == nullptr)
+	{
+		return;
+	}
+
+	// players that leave keep the values of the last read
+	for (APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		const AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(PlayerState);
+		if (FPlayerStats* Stats = FindStats(ShooterPlayerState))
+		{
+			Stats->Shots = ShooterPlayerState->GetNumBulletsFired() + ShooterPlayerState->GetNumRocketsFired();
+			Stats->Hits = ShooterPlayerState->GetHits();
+			Stats->Kills = ShooterPlayerState->GetKills();
+			Stats->Deaths = ShooterPlayerState->GetDeaths();
+			Stats->DamageDealt = ShooterPlayerState->GetDamageDealt();
+			Stats->DamageTaken = ShooterPlayerState->GetDamageTaken();
+		}
+	}
+}
+
+void UShooterReplayAnalyzer::SamplePositions(float DemoTime)
+{
+	for (AShooterCharacter* Character : TActorRange<AShooterCharacter>(GetWorld()))
+	{
+		FPlayerStats* Stats = Character->IsAlive() ? FindStats(Character) : nullptr;
+		if (Stats == nullptr)
+		{
+			continue;
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		if (Stats->LastSample != INDEX_NONE && Stats->LastSample == NumSamples - 1)
+		{
+			Stats->Distance += FVector::Dist(Stats->LastLocation, Location);
+		}
+		Stats->LastLocation = Location;
+		Stats->LastSample = NumSamples;
+
+		PositionRows += FString::Printf(TEXT("%.2f,\"%s\",%d,%.0f,%.0f,%.0f\n"), DemoTime, *Character->GetPlayerState()->GetPlayerName().Replace(TEXT("\""), TEXT("\"\"")), Stats->TeamNum, Location.X, Location.Y, Location.Z);
+	}
+
+	NumSamples++;
+}
+
+void UShooterReplayAnalyzer::Finish()
+{
+	bFinished = true;
+
+	ReadPlayerCounters();
+
+	FString OutputPath;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("AnalyzeOutput="), OutputPath))
+	{
+		OutputPath = FPaths::ProjectSavedDir() / TEXT("ReplayAnalysis") / FPaths::GetBaseFilename(GetReplayName());
+	}
+
+	FString PlayerRows = TEXT("Player,Team,Shots,Hits,Kills,Deaths,DamageDealt,DamageTaken,Distance\n");
+	for (const auto& It : Players)
+	{
+		const FPlayerStats& Stats = It.Value;
+		PlayerRows += FString::Printf(TEXT("\"%s\",%d,%d,%d,%d,%d,%.0f,%.0f,%.0f\n"), *It.Key.Replace(TEXT("\""), TEXT("\"\"")), Stats.TeamNum, Stats.Shots, Stats.Hits, Stats.Kills, Stats.Deaths, Stats.DamageDealt, Stats.DamageTaken, Stats.Distance);
+	}
+
+	const bool bSaved = FFileHelper::SaveStringToFile(PlayerRows, *(OutputPath + TEXT(".csv")))
+		&& FFileHelper::SaveStringToFile(TEXT("Time,Player,Team,X,Y,Z\n") + PositionRows, *(OutputPath + TEXT("_positions.csv")));
+
+	UE_LOG(LogShooter, Display, TEXT("Analyzed replay %s: %d players, written to %s.csv: %s"), *GetReplayName(), Players.Num(), *OutputPath, bSaved ? TEXT("OK") : TEXT("FAILED"));
+
+	FPlatformMisc::RequestExitWithStatus(false, bSaved ? 0 : 1);
+}
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterReplayAnalyzerCommandlet.h"
+
+UShooterReplayAnalyzerCommandlet::UShooterReplayAnalyzerCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UShooterReplayAnalyzerCommandlet::Main(const FString& Params)
+{
+	const TCHAR* Cmd = *Params;
+
+	// replays outside of the streamer's own directory are passed to it with their full path
+	FString ReplayDir = FPaths::ProjectSavedDir() / TEXT("Demos");
+	const bool bCustomReplayDir = FParse::Value(Cmd, TEXT("ReplayDir="), ReplayDir);
+	ReplayDir = FPaths::ConvertRelativePathToFull(ReplayDir);
+
+	FString OutputDir = FPaths::ProjectSavedDir() / TEXT("ReplayAnalysis");
+	FParse::Value(Cmd, TEXT("OutputDir="), OutputDir);
+	OutputDir = FPaths::ConvertRelativePathToFull(OutputDir);
+
+	int32 NumJobs = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	FParse::Value(Cmd, TEXT("Jobs="), NumJobs);
+	NumJobs = FMath::Max(NumJobs, 1);
+
+	TArray<FString> Replays;
+	FString ReplayList;
+	if (FParse::Value(Cmd, TEXT("Replays="), ReplayList))
+	{
+		ReplayList.ParseIntoArray(Replays, TEXT("+"));
+	}
+	else
+	{
+		IFileManager::Get().FindFiles(Replays, *(ReplayDir / TEXT("*.replay")), true, false);
+		for (FString& Replay : Replays)
+		{
+			Replay = FPaths::GetBaseFilename(Replay);
+		}
+	}
+
+	if (Replays.Num() == 0)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("No replays to analyze"));
+		return 0;
+	}
+
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	// the game processes run from the same executable, the editor one needs to be told to run the game
+	const FString Executable = FPlatformProcess::ExecutablePath();
+	FString CommonArgs = TEXT("-nullrhi -nosound -unattended -nosplash -benchmark -fps=20");
+	if (GIsEditor || IsRunningCommandlet())
+	{
+		CommonArgs = FString::Printf(TEXT("\"%s\" -game %s"), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()), *CommonArgs);
+	}
+
+	struct FJob
+	{
+		FString Replay;
+		FProcHandle Handle;
+	};
+	TArray<FJob> RunningJobs;
+
+	int32 NextReplay = 0;
+	int32 NumFailed = 0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	while (NextReplay < Replays.Num() || RunningJobs.Num() > 0)
+	{
+		while (NextReplay < Replays.Num() && RunningJobs.Num() < NumJobs)
+		{
+			const FString& Replay = Replays[NextReplay++];
+			const FString ReplayName = bCustomReplayDir ? ReplayDir / Replay : Replay;
+			const FString Args = FString::Printf(TEXT("%s -AnalyzeReplay=\"%s\" -AnalyzeOutput=\"%s\""), *CommonArgs, *ReplayName, *(OutputDir / Replay));
+
+			FProcHandle Handle = FPlatformProcess::CreateProc(*Executable, *Args, true, true, true, nullptr, 0, nullptr, nullptr);
+			if (Handle.IsValid())
+			{
+				RunningJobs.Add({ Replay, Handle });
+			}
+			else
+			{
+				UE_LOG(LogShooter, Error, TEXT("Failed to start the analysis of replay %s"), *Replay);
+				NumFailed++;
+			}
+		}
+
+		for (int32 i = RunningJobs.Num() - 1; i >= 0; i--)
+		{
+			FJob& Job = RunningJobs[i];
+			if (FPlatformProcess::IsProcRunning(Job.Handle))
+			{
+				continue;
+			}
+
+			int32 ReturnCode = 0;
+			FPlatformProcess::GetProcReturnCode(Job.Handle, &ReturnCode);
+			FPlatformProcess::CloseProc(Job.Handle);
+
+			if (ReturnCode != 0)
+			{
+				UE_LOG(LogShooter, Error, TEXT("Analysis of replay %s failed with code %d"), *Job.Replay, ReturnCode);
+				NumFailed++;
+			}
+			RunningJobs.RemoveAtSwap(i);
+		}
+
+		FPlatformProcess::Sleep(0.1f);
+	}
+
+	UE_LOG(LogShooter, Display, TEXT("Analyzed %d replays (%d failed) in %.1fs with %d jobs, results in %s"), Replays.Num(), NumFailed, FPlatformTime::Seconds() - StartTime, NumJobs, *OutputDir);
+
+	return NumFailed > 0 ? 1 : 0;
+}
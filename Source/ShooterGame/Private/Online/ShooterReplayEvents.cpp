@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterReplayEvents.h"
+#include "Engine/DemoNetDriver.h"
+#include "Algo/BinarySearch.h"
+
+const FString ShooterReplayEvents::KillGroup(TEXT("Kills"));
+const FString ShooterReplayEvents::MatchStateGroup(TEXT("MatchState"));
+const FString ShooterReplayEvents::ScoreGroup(TEXT("Score"));
+
+void ShooterReplayEvents::Record(UWorld* World, const FString& Group, const FString& Meta)
+{
+	UDemoNetDriver* DemoDriver = World ? World->GetDemoNetDriver() : nullptr;
+	if (DemoDriver && DemoDriver->IsRecording())
+	{
+		DemoDriver->AddEvent(Group, Meta, TArray<uint8>());
+	}
+}
+
+void FShooterReplayEventIndex::Build(UDemoNetDriver* DemoDriver)
+{
+	KillTimes.Reset();
+
+	if (DemoDriver && DemoDriver->ReplayStreamer.IsValid())
+	{
+		DemoDriver->ReplayStreamer->EnumerateEvents(ShooterReplayEvents::KillGroup, FEnumerateEventsCallback::CreateSP(this, &FShooterReplayEventIndex::OnKillsEnumerated));
+	}
+}
+
+void FShooterReplayEventIndex::OnKillsEnumerated(const FEnumerateEventsResult& Result)
+{
+	if (!Result.WasSuccessful())
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to enumerate the kills of the replay"));
+		return;
+	}
+
+	KillTimes.Reset(Result.ReplayEventList.ReplayEvents.Num());
+	for (const FReplayEventListItem& Event : Result.ReplayEventList.ReplayEvents)
+	{
+		KillTimes.Add(Event.Time1 / 1000.f);
+	}
+	KillTimes.Sort();
+}
+
+float FShooterReplayEventIndex::FindNextKillTime(float Time) const
+{
+	const int32 Index = Algo::UpperBound(KillTimes, Time);
+	return KillTimes.IsValidIndex(Index) ? KillTimes[Index] : -1.f;
+}
+
+float FShooterReplayEventIndex::FindPreviousKillTime(float Time) const
+{
+	const int32 Index = Algo::LowerBound(KillTimes, Time) - 1;
+	return KillTimes.IsValidIndex(Index) ? KillTimes[Index] : -1.f;
+}
@@ -26,19 +26,27 @@
 *		UReplicationGraphNode_GridSpatialization2D: 
 *		This is the spatialization node. All "distance based relevant" actors will be routed here. This node divides the map into a 2D grid. Each cell in the grid contains 
 *		children nodes that hold lists of actors based on how they update/go dormant. Actors are put in multiple cells. Connections pull from the single cell they are in.
+*		The grid's bias and cell size are derived from the bounds and actor density of the map when it loads, see UShooterReplicationGraph::ConfigureGridForWorld.
+*		Maps can override both with MapGridSettings in the [/Script/ShooterGame.ShooterReplicationGraph] section of DefaultEngine.ini.
 *		
 *		UReplicationGraphNode_ActorList
 *		This is an actor list node that contains the always relevant actors. These actors are always relevant to every connection.
 *		
 *		UShooterReplicationGraphNode_AlwaysRelevant_ForConnection
-*		This is the node for connection specific always relevant actors. This node does not maintain a persistent list but builds it each frame. This is possible because (currently)
-*		these actors are all easily accessed from the PlayerController. A persistent list would require notifications to be broadcast when these actors change, which would be possible
-*		but currently not necessary.
+*		This is the node for connection specific always relevant actors. These actors are all easily accessed from the PlayerController. The list is cached and only rebuilt when
+*		a viewer's pawn, view target, player state or inventory changes, or when the graph marks it dirty (weapon equip/unequip, gameplay debugger owner change).
+*		Always relevant streaming level actors are returned while their level has non dormant actors. The graph keeps that count per level from dormancy change events.
 *		
 *		UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
 *		A custom node for handling player state replication. This replicates a small rolling set of player states (currently 2/frame). This is so player states replicate
 *		to simulated connections at a low, steady frequency, and to take advantage of serialization sharing. Auto proxy player states are replicated at higher frequency (to the
-*		owning connection only) via UShooterReplicationGraphNode_AlwaysRelevant_ForConnection.
+*		owning connection only) via UShooterReplicationGraphNode_AlwaysRelevant_ForConnection. The buckets are persistent and maintained from add/remove notifications.
+*		Each connection additionally gets its teammates' and nearby players' states every few frames.
+*		
+*		UShooterReplicationGraphNode_Broadcast
+*		Spectator only connections (e.g. tournament casters and viewers) skip the grid and the per connection player state priority lists. Instead they all get this one
+*		shared list of every spatialized actor, on the same frames (SpectatorReplicationPeriodFrame), so each actor is serialized once for all of them and 200 spectators cost
+*		about as much as one. Players waiting to respawn are not broadcast connections.
 *		
 *		UReplicationGraphNode_TearOff_ForConnection
 *		Connection specific node for handling tear off actors. This is created and managed in the base implementation of Replication Graph.
@@ -51,6 +59,12 @@
 *		
 *		See UShooterReplicationGraph::OnCharacterWeaponChange: this is how actors are added/removed from the dependent actor list. 
 *	
+*	Fast Shared Path (AShooterCharacter)
+*	
+*		Character movement (location, velocity, aim pitch, movement mode including wall running) is also sent through the fast shared path. AShooterCharacter::UpdateSharedReplication
+*		is called once per frame and serializes an unreliable multicast whose bunch is shared by every connection the character is not fully replicated to that frame.
+*		"ShooterRepGraph.BenchmarkSharedRep <Frames>" replicates that many frames with and without the fast path and logs the replication time and bytes sent of both.
+*	
 *	How To Use
 *	
 *		Making something always relevant: Please avoid if you can :) If you must, just setting AActor::bAlwaysRelevant = true in the class defaults will do it.
@@ -93,6 +107,8 @@
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/Pawn.h"
 #include "Engine/LevelScriptActor.h"
+#include "Engine/LevelBounds.h"
+#include "GameFramework/PlayerStart.h"
 #include "Player/ShooterCharacter.h"
 #include "Online/ShooterPlayerState.h"
 #include "Weapons/ShooterWeapon.h"
@@ -106,14 +122,15 @@ static FAutoConsoleVariableRef CVarShooterRepGraphDestructMaxDist(TEXT("ShooterR
 int32 CVar_ShooterRepGraph_DisplayClientLevelStreaming = 0;
 static FAutoConsoleVariableRef CVarShooterRepGraphDisplayClientLevelStreaming(TEXT("ShooterRepGraph.DisplayClientLevelStreaming"), CVar_ShooterRepGraph_DisplayClientLevelStreaming, TEXT(""), ECVF_Default );
 
-float CVar_ShooterRepGraph_CellSize = 10000.f;
-static FAutoConsoleVariableRef CVarShooterRepGraphCellSize(TEXT("ShooterRepGraph.CellSize"), CVar_ShooterRepGraph_CellSize, TEXT(""), ECVF_Default );
+// 0 derives the cell size from the map, see UShooterReplicationGraph::ConfigureGridForWorld. Per map config overrides this.
+float CVar_ShooterRepGraph_CellSize = 0.f;
+static FAutoConsoleVariableRef CVarShooterRepGraphCellSize(TEXT("ShooterRepGraph.CellSize"), CVar_ShooterRepGraph_CellSize, TEXT("Cell size of the spatial grid, 0 to derive it from the map"), ECVF_Default );
 
-// Essentially "Min X" for replication. This is just an initial value. The system will reset itself if actors appears outside of this.
+// Essentially "Min X" for replication, only used for maps without any bounds. The system will reset itself if actors appears outside of this.
 float CVar_ShooterRepGraph_SpatialBiasX = -150000.f;
 static FAutoConsoleVariableRef CVarShooterRepGraphSpatialBiasX(TEXT("ShooterRepGraph.SpatialBiasX"), CVar_ShooterRepGraph_SpatialBiasX, TEXT(""), ECVF_Default );
 
-// Essentially "Min Y" for replication. This is just an initial value. The system will reset itself if actors appears outside of this.
+// Essentially "Min Y" for replication, only used for maps without any bounds. The system will reset itself if actors appears outside of this.
 float CVar_ShooterRepGraph_SpatialBiasY = -200000.f;
 static FAutoConsoleVariableRef CVarShooterRepSpatialBiasY(TEXT("ShooterRepGraph.SpatialBiasY"), CVar_ShooterRepGraph_SpatialBiasY, TEXT(""), ECVF_Default );
 
@@ -121,14 +138,27 @@ static FAutoConsoleVariableRef CVarShooterRepSpatialBiasY(TEXT("ShooterRepGraph.
 int32 CVar_ShooterRepGraph_DynamicActorFrequencyBuckets = 3;
 static FAutoConsoleVariableRef CVarShooterRepDynamicActorFrequencyBuckets(TEXT("ShooterRepGraph.DynamicActorFrequencyBuckets"), CVar_ShooterRepGraph_DynamicActorFrequencyBuckets, TEXT(""), ECVF_Default );
 
-int32 CVar_ShooterRepGraph_DisableSpatialRebuilds = 1;
-static FAutoConsoleVariableRef CVarShooterRepDisableSpatialRebuilds(TEXT("ShooterRepGraph.DisableSpatialRebuilds"), CVar_ShooterRepGraph_DisableSpatialRebuilds, TEXT(""), ECVF_Default );
+int32 CVar_ShooterRepGraph_EnableBroadcast = 1;
+static FAutoConsoleVariableRef CVarShooterRepEnableBroadcast(TEXT("ShooterRepGraph.EnableBroadcast"), CVar_ShooterRepGraph_EnableBroadcast, TEXT("1: spectator only connections share one replication list, 0: they are gathered like players"), ECVF_Default );
+
+int32 CVar_ShooterRepGraph_DisableSpatialRebuilds = 0;
+static FAutoConsoleVariableRef CVarShooterRepDisableSpatialRebuilds(TEXT("ShooterRepGraph.DisableSpatialRebuilds"), CVar_ShooterRepGraph_DisableSpatialRebuilds, TEXT("1: no class rebuilds the grid, 0: only SpatialRebuildClasses do"), ECVF_Default );
+
+int32 CVar_ShooterRepGraph_EnableFastSharedPath = 1;
+static FAutoConsoleVariableRef CVarShooterRepEnableFastSharedPath(TEXT("ShooterRepGraph.EnableFastSharedPath"), CVar_ShooterRepGraph_EnableFastSharedPath, TEXT("1: characters send their movement through the fast shared path on the frames they aren't fully replicated, read when the graph is created"), ECVF_Default );
 
 // ----------------------------------------------------------------------------------------------------------
 
 
 UShooterReplicationGraph::UShooterReplicationGraph()
 {
+	// Pawns can be knocked or fall out of the grid and still need to replicate correctly. Projectiles and effects can live with being clamped.
+	SpatialRebuildClasses.Add(APawn::StaticClass());
+
+	TargetActorsPerCell = 8.f;
+	MinCellSize = 5000.f;
+	MaxCellSize = 20000.f;
+	SpectatorReplicationPeriodFrame = 2;
 }
 
 void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize, float ServerMaxTickRate)
@@ -156,6 +186,7 @@ void UShooterReplicationGraph::ResetGameWorldState()
 	Super::ResetGameWorldState();
 
 	AlwaysRelevantStreamingLevelActors.Empty();
+	AlwaysRelevantStreamingLevelNonDormantCounts.Empty();
 
 	for (UNetReplicationGraphConnection* ConnManager : Connections)
 	{
@@ -192,7 +223,7 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 
 	AddInfo( AShooterWeapon::StaticClass(),							EClassRepNodeMapping::NotRouted);				// Handled via DependantActor replication (Pawn)
 	AddInfo( ALevelScriptActor::StaticClass(),						EClassRepNodeMapping::NotRouted);				// Not needed
-	AddInfo( APlayerState::StaticClass(),							EClassRepNodeMapping::NotRouted);				// Special cased via UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
+	AddInfo( APlayerState::StaticClass(),							EClassRepNodeMapping::PlayerStateFrequencyLimited);	// Special cased via UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
 	AddInfo( AReplicationGraphDebugActor::StaticClass(),			EClassRepNodeMapping::NotRouted);				// Not needed. Replicated special case inside RepGraph
 	AddInfo( AInfo::StaticClass(),									EClassRepNodeMapping::RelevantAllConnections);	// Non spatialized, relevant to all
 	AddInfo( AShooterPickup::StaticClass(),							EClassRepNodeMapping::Spatialize_Static);		// Spatialized and never moves. Routes to GridNode.
@@ -284,6 +315,12 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	PawnClassRepInfo.SetCullDistanceSquared(15000.f * 15000.f); // Yuck
 	SetClassInfo( APawn::StaticClass(), PawnClassRepInfo );
 
+	// Character movement goes through the fast shared path: serialized once per frame and the bunch is shared by all connections
+	FClassReplicationInfo CharacterClassRepInfo = PawnClassRepInfo;
+	CharacterClassRepInfo.FastSharedReplicationFunc = [](AActor* Actor) { return CastChecked<AShooterCharacter>(Actor)->UpdateSharedReplication(); };
+	CharacterClassRepInfo.FastSharedReplicationFuncName = GET_FUNCTION_NAME_CHECKED(AShooterCharacter, FastSharedReplication);
+	SetClassInfo( AShooterCharacter::StaticClass(), CharacterClassRepInfo );
+
 	FClassReplicationInfo PlayerStateRepInfo;
 	PlayerStateRepInfo.DistancePriorityScale = 0.f;
 	PlayerStateRepInfo.ActorChannelFrameTimeout = 0;
@@ -291,6 +328,10 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	
 	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.ListSize = 12;
 
+	// Dynamic actors that aren't fully replicated to a connection this frame go through their fast shared path instead (characters only)
+	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.EnableFastPath = CVar_ShooterRepGraph_EnableFastSharedPath > 0;
+	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.FastPathFrameModulo = 1;
+
 	// Set FClassReplicationInfo based on legacy settings from all replicated classes
 	for (UClass* ReplicatedClass : AllReplicatedClasses)
 	{
@@ -368,14 +409,31 @@ void UShooterReplicationGraph::InitGlobalGraphNodes()
 	//	Spatial Actors
 	// -----------------------------------------------
 
-	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
-	GridNode->CellSize = CVar_ShooterRepGraph_CellSize;
+	GridNode = CreateNewNode<UShooterReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = CVar_ShooterRepGraph_CellSize > 0.f ? CVar_ShooterRepGraph_CellSize : MaxCellSize;
 	GridNode->SpatialBias = FVector2D(CVar_ShooterRepGraph_SpatialBiasX, CVar_ShooterRepGraph_SpatialBiasY);
 
+	if (NetDriver && NetDriver->GetWorld())
+	{
+		ConfigureGridForWorld(NetDriver->GetWorld());
+	}
+
 	if (CVar_ShooterRepGraph_DisableSpatialRebuilds)
 	{
 		GridNode->AddSpatialRebuildBlacklistClass(AActor::StaticClass()); // Disable All spatial rebuilding
 	}
+	else
+	{
+		// Rebuilding the grid is expensive, only the classes that need to be exact outside of it may trigger it. The rest is clamped to the edge cells.
+		for (auto ClassMapIt = ClassRepNodePolicies.CreateIterator(); ClassMapIt; ++ClassMapIt)
+		{
+			UClass* Class = CastChecked<UClass>(ClassMapIt.Key().ResolveObjectPtr());
+			if (IsSpatialized(ClassMapIt.Value()) && !SpatialRebuildClasses.ContainsByPredicate([&](const TSubclassOf<AActor>& RebuildClass) { return Class->IsChildOf(RebuildClass); }))
+			{
+				GridNode->AddSpatialRebuildBlacklistClass(Class);
+			}
+		}
+	}
 	
 	AddGlobalGraphNode(GridNode);
 
@@ -388,8 +446,94 @@ void UShooterReplicationGraph::InitGlobalGraphNodes()
 	// -----------------------------------------------
 	//	Player State specialization. This will return a rolling subset of the player states to replicate
 	// -----------------------------------------------
-	UShooterReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = CreateNewNode<UShooterReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode = CreateNewNode<UShooterReplicationGraphNode_PlayerStateFrequencyLimiter>();
 	AddGlobalGraphNode(PlayerStateNode);
+
+	// -----------------------------------------------
+	//	Broadcast. Spectator only connections get every spatialized actor from this one shared list instead of gathering the grid.
+	// -----------------------------------------------
+	BroadcastNode = CreateNewNode<UShooterReplicationGraphNode_Broadcast>();
+	// a channel not replicated for ActorChannelFrameTimeout frames is closed, a longer period would reopen them every time
+	const int32 MaxSpectatorReplicationPeriodFrame = PawnClassRepInfo.ActorChannelFrameTimeout - 1;
+	if (SpectatorReplicationPeriodFrame > MaxSpectatorReplicationPeriodFrame)
+	{
+		UE_LOG(LogShooterReplicationGraph, Warning, TEXT("SpectatorReplicationPeriodFrame %d is clamped to %d, the actor channel frame timeout is %d"), SpectatorReplicationPeriodFrame, MaxSpectatorReplicationPeriodFrame, PawnClassRepInfo.ActorChannelFrameTimeout);
+	}
+	BroadcastNode->ReplicationPeriodFrame = FMath::Clamp(SpectatorReplicationPeriodFrame, 1, MaxSpectatorReplicationPeriodFrame);
+	AddGlobalGraphNode(BroadcastNode);
+}
+
+void UShooterReplicationGraph::InitializeForWorld(UWorld* World)
+{
+	// Before Super, which adds the world's actors to the grid
+	if (World && GridNode)
+	{
+		ConfigureGridForWorld(World);
+	}
+
+	Super::InitializeForWorld(World);
+}
+
+void UShooterReplicationGraph::ConfigureGridForWorld(UWorld* World)
+{
+	const FString MapName = UWorld::RemovePIEPrefix(World->GetMapName());
+	const FShooterRepGraphMapSettings* MapSettings = MapGridSettings.FindByPredicate([&](const FShooterRepGraphMapSettings& Settings) { return Settings.MapName == MapName; });
+
+	// Bounds of everything placed in the loaded levels, and how many spatialized actors are in there. Each player start will hold a pawn at some point.
+	FBox Bounds(ForceInit);
+	int32 NumSpatializedActors = 0;
+	for (ULevel* Level : World->GetLevels())
+	{
+		if (Level == nullptr)
+		{
+			continue;
+		}
+
+		// A level bounds actor placed by hand leaves out sky boxes and other far away dressing
+		Bounds += (Level->LevelBoundsActor.IsValid() && !Level->LevelBoundsActor->bAutoUpdateBounds) ? Level->LevelBoundsActor->GetComponentsBoundingBox() : ALevelBounds::CalculateLevelBounds(Level);
+
+		for (AActor* Actor : Level->Actors)
+		{
+			if (Actor && ((Actor->GetIsReplicated() && IsSpatialized(GetMappingPolicy(Actor->GetClass()))) || Actor->IsA<APlayerStart>()))
+			{
+				++NumSpatializedActors;
+			}
+		}
+	}
+
+	float CellSize = GridNode->CellSize;
+	FVector2D SpatialBias = GridNode->SpatialBias;
+
+	if (MapSettings && MapSettings->CellSize > 0.f)
+	{
+		CellSize = MapSettings->CellSize;
+	}
+	else if (CVar_ShooterRepGraph_CellSize > 0.f)
+	{
+		CellSize = CVar_ShooterRepGraph_CellSize;
+	}
+	else if (Bounds.IsValid)
+	{
+		const FVector Size = Bounds.GetSize();
+		const float NumCells = FMath::Max(NumSpatializedActors / FMath::Max(TargetActorsPerCell, 1.f), 1.f);
+		CellSize = FMath::Clamp(FMath::Sqrt(FMath::Max(Size.X * Size.Y, 1.f) / NumCells), MinCellSize, MaxCellSize);
+	}
+
+	if (MapSettings && MapSettings->bOverrideSpatialBias)
+	{
+		SpatialBias = MapSettings->SpatialBias;
+	}
+	else if (Bounds.IsValid)
+	{
+		// One cell of margin so actors on the edge of the map don't trigger a rebuild or a clamp
+		SpatialBias = FVector2D(Bounds.Min.X - CellSize, Bounds.Min.Y - CellSize);
+	}
+
+	GridNode->CellSize = CellSize;
+	GridNode->SpatialBias = SpatialBias;
+
+	UE_LOG(LogShooterReplicationGraph, Log, TEXT("Spatial grid for %s: CellSize %.0f, SpatialBias %s (%d spatialized actors, bounds %s%s)"),
+		*MapName, CellSize, *SpatialBias.ToString(), NumSpatializedActors, *Bounds.ToString(), MapSettings ? TEXT(", map config") : TEXT(""));
 }
 
 void UShooterReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
@@ -433,25 +577,42 @@ void UShooterReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedA
 				FActorRepListRefView& RepList = AlwaysRelevantStreamingLevelActors.FindOrAdd(ActorInfo.StreamingLevelName);
 				RepList.PrepareForWrite();
 				RepList.ConditionalAdd(ActorInfo.Actor);
+
+				int32& NumNonDormant = AlwaysRelevantStreamingLevelNonDormantCounts.FindOrAdd(ActorInfo.StreamingLevelName);
+				if (ActorInfo.Actor->NetDormancy <= DORM_Awake)
+				{
+					++NumNonDormant;
+				}
+
+				GlobalInfo.Events.DormancyChange.AddUObject(this, &UShooterReplicationGraph::OnAlwaysRelevantStreamingActorDormancyChange);
 			}
 			break;
 		}
 
+		case EClassRepNodeMapping::PlayerStateFrequencyLimited:
+		{
+			PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+			break;
+		}
+
 		case EClassRepNodeMapping::Spatialize_Static:
 		{
 			GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+			BroadcastNode->NotifyAddNetworkActor(ActorInfo);
 			break;
 		}
 		
 		case EClassRepNodeMapping::Spatialize_Dynamic:
 		{
 			GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+			BroadcastNode->NotifyAddNetworkActor(ActorInfo);
 			break;
 		}
 		
 		case EClassRepNodeMapping::Spatialize_Dormancy:
 		{
 			GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+			BroadcastNode->NotifyAddNetworkActor(ActorInfo);
 			break;
 		}
 	};
@@ -479,26 +640,45 @@ void UShooterReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicat
 				if (RepList.Remove(ActorInfo.Actor) == false)
 				{
 					UE_LOG(LogShooterReplicationGraph, Warning, TEXT("Actor %s was not found in AlwaysRelevantStreamingLevelActors list. LevelName: %s"), *GetActorRepListTypeDebugString(ActorInfo.Actor), *ActorInfo.StreamingLevelName.ToString());
-				}				
+				}
+				else if (ActorInfo.Actor->NetDormancy <= DORM_Awake)
+				{
+					int32& NumNonDormant = AlwaysRelevantStreamingLevelNonDormantCounts.FindOrAdd(ActorInfo.StreamingLevelName);
+					NumNonDormant = FMath::Max(NumNonDormant - 1, 0);
+				}
+
+				if (FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(ActorInfo.Actor))
+				{
+					GlobalInfo->Events.DormancyChange.RemoveAll(this);
+				}
 			}
 			break;
 		}
 
+		case EClassRepNodeMapping::PlayerStateFrequencyLimited:
+		{
+			PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+			break;
+		}
+
 		case EClassRepNodeMapping::Spatialize_Static:
 		{
 			GridNode->RemoveActor_Static(ActorInfo);
+			BroadcastNode->NotifyRemoveNetworkActor(ActorInfo);
 			break;
 		}
 		
 		case EClassRepNodeMapping::Spatialize_Dynamic:
 		{
 			GridNode->RemoveActor_Dynamic(ActorInfo);
+			BroadcastNode->NotifyRemoveNetworkActor(ActorInfo);
 			break;
 		}
 		
 		case EClassRepNodeMapping::Spatialize_Dormancy:
 		{
 			GridNode->RemoveActor_Dormancy(ActorInfo);
+			BroadcastNode->NotifyRemoveNetworkActor(ActorInfo);
 			break;
 		}
 	};
@@ -518,6 +698,11 @@ void UShooterReplicationGraph::OnCharacterEquipWeapon(AShooterCharacter* Charact
 		CHECK_WORLDS(Character);
 
 		GlobalActorReplicationInfoMap.AddDependentActor(Character, NewWeapon);
+
+		if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantNodeForConnection(Character->GetNetConnection()))
+		{
+			AlwaysRelevantConnectionNode->MarkActorListDirty();
+		}
 	}
 }
 
@@ -528,122 +713,220 @@ void UShooterReplicationGraph::OnCharacterUnEquipWeapon(AShooterCharacter* Chara
 		CHECK_WORLDS(Character);
 
 		GlobalActorReplicationInfoMap.RemoveDependentActor(Character, OldWeapon);
+
+		if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantNodeForConnection(Character->GetNetConnection()))
+		{
+			AlwaysRelevantConnectionNode->MarkActorListDirty();
+		}
 	}
 }
 
-#if WITH_GAMEPLAY_DEBUGGER
-void UShooterReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
+UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* UShooterReplicationGraph::GetAlwaysRelevantNodeForConnection(UNetConnection* NetConnection)
 {
-	auto GetAlwaysRelevantForConnectionNode = [&](APlayerController* Controller) -> UShooterReplicationGraphNode_AlwaysRelevant_ForConnection*
+	if (NetConnection)
 	{
-		if (OldOwner)
+		if (UNetReplicationGraphConnection* GraphConnection = FindOrAddConnectionManager(NetConnection))
 		{
-			if (UNetConnection* NetConnection = OldOwner->GetNetConnection())
+			for (UReplicationGraphNode* ConnectionNode : GraphConnection->GetConnectionGraphNodes())
 			{
-				if (UNetReplicationGraphConnection* GraphConnection = FindOrAddConnectionManager(NetConnection))
+				if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = Cast<UShooterReplicationGraphNode_AlwaysRelevant_ForConnection>(ConnectionNode))
 				{
-					for (UReplicationGraphNode* ConnectionNode : GraphConnection->GetConnectionGraphNodes())
-					{
-						if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = Cast<UShooterReplicationGraphNode_AlwaysRelevant_ForConnection>(ConnectionNode))
-						{
-							return AlwaysRelevantConnectionNode;
-						}
-					}
-
+					return AlwaysRelevantConnectionNode;
 				}
 			}
 		}
+	}
 
-		return nullptr;
-	};
+	return nullptr;
+}
+
+void UShooterReplicationGraph::OnAlwaysRelevantStreamingActorDormancyChange(FActorRepListType Actor, FGlobalActorReplicationInfo& GlobalInfo, ENetDormancy NewValue, ENetDormancy OldValue)
+{
+	const bool bWasAwake = OldValue <= DORM_Awake;
+	const bool bIsAwake = NewValue <= DORM_Awake;
+	if (bWasAwake == bIsAwake)
+	{
+		return;
+	}
 
-	if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantForConnectionNode(OldOwner))
+	const FName StreamingLevelName = FNewReplicatedActorInfo(Actor).StreamingLevelName;
+
+	int32& NumNonDormant = AlwaysRelevantStreamingLevelNonDormantCounts.FindOrAdd(StreamingLevelName);
+	NumNonDormant = FMath::Max(NumNonDormant + (bIsAwake ? 1 : -1), 0);
+
+	if (bIsAwake)
+	{
+		// Connections may have stopped gathering this level once everything in it went dormant
+		for (UNetReplicationGraphConnection* ConnManager : Connections)
+		{
+			for (UReplicationGraphNode* ConnectionNode : ConnManager->GetConnectionGraphNodes())
+			{
+				if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = Cast<UShooterReplicationGraphNode_AlwaysRelevant_ForConnection>(ConnectionNode))
+				{
+					AlwaysRelevantConnectionNode->OnStreamingLevelActorAwake(StreamingLevelName);
+				}
+			}
+		}
+	}
+}
+
+#if WITH_GAMEPLAY_DEBUGGER
+void UShooterReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
+{
+	if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantNodeForConnection(OldOwner ? OldOwner->GetNetConnection() : nullptr))
 	{
 		AlwaysRelevantConnectionNode->GameplayDebugger = nullptr;
+		AlwaysRelevantConnectionNode->MarkActorListDirty();
 	}
 
-	if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantForConnectionNode(Debugger->GetReplicationOwner()))
+	APlayerController* NewOwner = Debugger->GetReplicationOwner();
+	if (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantNodeForConnection(NewOwner ? NewOwner->GetNetConnection() : nullptr))
 	{
 		AlwaysRelevantConnectionNode->GameplayDebugger = Debugger;
+		AlwaysRelevantConnectionNode->MarkActorListDirty();
 	}
 }
 #endif
 
+bool UShooterReplicationGraph::IsBroadcastConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (CVar_ShooterRepGraph_EnableBroadcast == 0 || Params.Viewers.Num() == 0)
+	{
+		return false;
+	}
+
+	for (const FNetViewer& CurViewer : Params.Viewers)
+	{
+		// Players waiting to respawn are spectating too, but they must not see the whole map
+		const APlayerController* PC = Cast<APlayerController>(CurViewer.InViewer);
+		if (PC == nullptr || PC->PlayerState == nullptr || !PC->PlayerState->IsOnlyASpectator())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------
+
+void UShooterReplicationGraphNode_GridSpatialization2D::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (!UShooterReplicationGraph::IsBroadcastConnection(Params))
+	{
+		Super::GatherActorListsForConnection(Params);
+	}
+}
+
+// ------------------------------------------------------------------------------
+
+void UShooterReplicationGraphNode_Broadcast::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	// Every spectator gets the list on the same frames, so each actor is serialized once for all of them
+	if (Params.ReplicationFrameNum % ReplicationPeriodFrame == 0 && UShooterReplicationGraph::IsBroadcastConnection(Params))
+	{
+		Super::GatherActorListsForConnection(Params);
+	}
+}
+
 // ------------------------------------------------------------------------------
 
 void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::ResetGameWorldState()
 {
+	AlwaysRelevantStreamingLevelsVisible.Empty();
 	AlwaysRelevantStreamingLevelsNeedingReplication.Empty();
+	CachedViewers.Reset();
+	bActorListDirty = true;
 }
 
-void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+bool UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::HaveViewersChanged(const FConnectionGatherActorListParameters& Params) const
 {
-	QUICK_SCOPE_CYCLE_COUNTER( UShooterReplicationGraphNode_AlwaysRelevant_ForConnection_GatherActorListsForConnection );
-
-	UShooterReplicationGraph* ShooterGraph = CastChecked<UShooterReplicationGraph>(GetOuter());
+	if (Params.Viewers.Num() != CachedViewers.Num())
+	{
+		return true;
+	}
 
-	ReplicationActorList.Reset();
+	for (int32 ViewerIdx = 0; ViewerIdx < CachedViewers.Num(); ++ViewerIdx)
+	{
+		const FNetViewer& CurViewer = Params.Viewers[ViewerIdx];
+		const FCachedViewer& CachedViewer = CachedViewers[ViewerIdx];
 
-	auto ResetActorCullDistance = [&](AActor* ActorToSet, AActor*& LastActor) {
+		if (CachedViewer.InViewer.Get() != CurViewer.InViewer || CachedViewer.ViewTarget.Get() != CurViewer.ViewTarget)
+		{
+			return true;
+		}
 
-		if (ActorToSet != LastActor)
+		if (const AShooterPlayerController* PC = Cast<AShooterPlayerController>(CurViewer.InViewer))
 		{
-			LastActor = ActorToSet;
+			if (CachedViewer.Pawn.Get() != PC->GetPawn() || CachedViewer.PlayerState.Get() != PC->PlayerState)
+			{
+				return true;
+			}
 
-			UE_LOG(LogShooterReplicationGraph, Verbose, TEXT("Setting pawn cull distance to 0. %s"), *ActorToSet->GetName());
-			FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(ActorToSet);
-			ConnectionActorInfo.SetCullDistanceSquared(0.f);
+			// Weapons picked up or dropped don't go through equip, the inventory size catches those
+			const AShooterCharacter* Pawn = Cast<AShooterCharacter>(PC->GetPawn());
+			if (Pawn && Pawn->GetInventoryCount() != CachedViewer.InventoryCount)
+			{
+				return true;
+			}
 		}
-	};
+	}
 
-	for (const FNetViewer& CurViewer : Params.Viewers)
+	return false;
+}
+
+void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::RebuildActorList(const FConnectionGatherActorListParameters& Params)
+{
+	ReplicationActorList.Reset();
+	PlayerStateActorList.Reset();
+
+	TArray<FCachedViewer, TInlineAllocator<2> > PreviousViewers = MoveTemp(CachedViewers);
+	CachedViewers.Reset();
+
+	for (int32 ViewerIdx = 0; ViewerIdx < Params.Viewers.Num(); ++ViewerIdx)
 	{
+		const FNetViewer& CurViewer = Params.Viewers[ViewerIdx];
+		const FCachedViewer* PreviousViewer = PreviousViewers.IsValidIndex(ViewerIdx) ? &PreviousViewers[ViewerIdx] : nullptr;
+
+		FCachedViewer& CachedViewer = CachedViewers.AddDefaulted_GetRef();
+		CachedViewer.InViewer = CurViewer.InViewer;
+		CachedViewer.ViewTarget = CurViewer.ViewTarget;
+
 		ReplicationActorList.ConditionalAdd(CurViewer.InViewer);
 		ReplicationActorList.ConditionalAdd(CurViewer.ViewTarget);
 
 		if (AShooterPlayerController* PC = Cast<AShooterPlayerController>(CurViewer.InViewer))
 		{
-			// 50% throttling of PlayerStates.
-			const bool bReplicatePS = (Params.ConnectionManager.ConnectionOrderNum % 2) == (Params.ReplicationFrameNum % 2);
-			if (bReplicatePS)
+			// Always return the player state to the owning player. Simulated proxy player states are handled by UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
+			if (APlayerState* PS = PC->PlayerState)
 			{
-				// Always return the player state to the owning player. Simulated proxy player states are handled by UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
-				if (APlayerState* PS = PC->PlayerState)
+				if (PreviousViewer == nullptr || PreviousViewer->PlayerState.Get() != PS)
 				{
-					if (!bInitializedPlayerState)
-					{
-						bInitializedPlayerState = true;
-						FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(PS);
-						ConnectionActorInfo.ReplicationPeriodFrame = 1;
-					}
-
-					ReplicationActorList.ConditionalAdd(PS);
+					FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(PS);
+					ConnectionActorInfo.ReplicationPeriodFrame = 1;
 				}
-			}
 
-			FAlwaysRelevantActorInfo* LastData = PastRelevantActors.FindByKey<UNetConnection*>(CurViewer.Connection);
-
-			// We've not seen this actor before, go ahead and add them.
-			if (LastData == nullptr)
-			{
-				FAlwaysRelevantActorInfo NewActorInfo;
-				NewActorInfo.Connection = CurViewer.Connection;
-				LastData = &(PastRelevantActors[PastRelevantActors.Add(NewActorInfo)]);
+				PlayerStateActorList.ConditionalAdd(PS);
 			}
 
-			check(LastData != nullptr);
+			CachedViewer.PlayerState = PC->PlayerState;
+			CachedViewer.Pawn = PC->GetPawn();
 
 			if (AShooterCharacter* Pawn = Cast<AShooterCharacter>(PC->GetPawn()))
 			{
-				ResetActorCullDistance(Pawn, static_cast<AActor*&>(LastData->LastViewer));
+				if (PreviousViewer == nullptr || PreviousViewer->Pawn.Get() != Pawn)
+				{
+					UE_LOG(LogShooterReplicationGraph, Verbose, TEXT("Setting pawn cull distance to 0. %s"), *Pawn->GetName());
+					Params.ConnectionManager.ActorInfoMap.FindOrAdd(Pawn).SetCullDistanceSquared(0.f);
+				}
 
 				if (Pawn != CurViewer.ViewTarget)
 				{
 					ReplicationActorList.ConditionalAdd(Pawn);
 				}
 
-				int32 InventoryCount = Pawn->GetInventoryCount();
-				for (int32 i = 0; i < InventoryCount; ++i)
+				CachedViewer.InventoryCount = Pawn->GetInventoryCount();
+				for (int32 i = 0; i < CachedViewer.InventoryCount; ++i)
 				{
 					AShooterWeapon* Weapon = Pawn->GetInventoryWeapon(i);
 					if (Weapon)
@@ -655,17 +938,46 @@ void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorLists
 
 			if (AShooterCharacter* ViewTargetPawn = Cast<AShooterCharacter>(CurViewer.ViewTarget))
 			{
-				ResetActorCullDistance(ViewTargetPawn, static_cast<AActor*&>(LastData->LastViewTarget));
+				if (PreviousViewer == nullptr || PreviousViewer->ViewTarget.Get() != ViewTargetPawn)
+				{
+					UE_LOG(LogShooterReplicationGraph, Verbose, TEXT("Setting view target cull distance to 0. %s"), *ViewTargetPawn->GetName());
+					Params.ConnectionManager.ActorInfoMap.FindOrAdd(ViewTargetPawn).SetCullDistanceSquared(0.f);
+				}
 			}
 		}
 	}
 
-	PastRelevantActors.RemoveAll([&](FAlwaysRelevantActorInfo& RelActorInfo) {
-		return RelActorInfo.Connection == nullptr;
-	});
+#if WITH_GAMEPLAY_DEBUGGER
+	if (GameplayDebugger)
+	{
+		ReplicationActorList.ConditionalAdd(GameplayDebugger);
+	}
+#endif
+
+	bActorListDirty = false;
+}
+
+void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	QUICK_SCOPE_CYCLE_COUNTER( UShooterReplicationGraphNode_AlwaysRelevant_ForConnection_GatherActorListsForConnection );
+
+	UShooterReplicationGraph* ShooterGraph = CastChecked<UShooterReplicationGraph>(GetOuter());
+
+	if (bActorListDirty || HaveViewersChanged(Params))
+	{
+		RebuildActorList(Params);
+	}
 
 	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
 
+	// 50% throttling of PlayerStates. Broadcast connections all use the same phase so they share the serialization.
+	const uint32 ThrottleOrderNum = UShooterReplicationGraph::IsBroadcastConnection(Params) ? 0 : Params.ConnectionManager.ConnectionOrderNum;
+	const bool bReplicatePS = (ThrottleOrderNum % 2) == (Params.ReplicationFrameNum % 2);
+	if (bReplicatePS && PlayerStateActorList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(PlayerStateActorList);
+	}
+
 	// Always relevant streaming level actors.
 	FPerConnectionActorInfoMap& ConnectionActorInfoMap = Params.ConnectionManager.ActorInfoMap;
 	
@@ -676,19 +988,20 @@ void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorLists
 		const FName& StreamingLevel = AlwaysRelevantStreamingLevelsNeedingReplication[Idx];
 
 		FActorRepListRefView* Ptr = AlwaysRelevantStreamingLevelActors.Find(StreamingLevel);
-		if (Ptr == nullptr)
+		if (Ptr == nullptr || Ptr->Num() == 0)
 		{
 			// No always relevant lists for that level
-			UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING Removing %s from AlwaysRelevantStreamingLevelActors because FActorRepListRefView is null. %s "), *StreamingLevel.ToString(),  *Params.ConnectionManager.GetName());
+			UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING Removing %s from AlwaysRelevantStreamingLevelActors because FActorRepListRefView is null or empty. %s "), *StreamingLevel.ToString(),  *Params.ConnectionManager.GetName());
 			AlwaysRelevantStreamingLevelsNeedingReplication.RemoveAtSwap(Idx, 1, false);
 			continue;
 		}
 
 		FActorRepListRefView& RepList = *Ptr;
 
-		if (RepList.Num() > 0)
+		// Only look at the per connection dormancy state once every actor of the level wants to be dormant, to make sure the last update made it to this connection
+		bool bAllDormant = ShooterGraph->GetNumNonDormantStreamingLevelActors(StreamingLevel) == 0;
+		if (bAllDormant)
 		{
-			bool bAllDormant = true;
 			for (FActorRepListType Actor : RepList)
 			{
 				FConnectionReplicationActorInfo& ConnectionActorInfo = ConnectionActorInfoMap.FindOrAdd(Actor);
@@ -698,50 +1011,50 @@ void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorLists
 					break;
 				}
 			}
+		}
 
-			if (bAllDormant)
-			{
-				UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING All AlwaysRelevant Actors Dormant on StreamingLevel %s for %s. Removing list."), *StreamingLevel.ToString(), *Params.ConnectionManager.GetName());
-				AlwaysRelevantStreamingLevelsNeedingReplication.RemoveAtSwap(Idx, 1, false);
-			}
-			else
-			{
-				UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING Adding always Actors on StreamingLevel %s for %s because it has at least one non dormant actor"), *StreamingLevel.ToString(), *Params.ConnectionManager.GetName());
-				Params.OutGatheredReplicationLists.AddReplicationActorList(RepList);
-			}
+		if (bAllDormant)
+		{
+			UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING All AlwaysRelevant Actors Dormant on StreamingLevel %s for %s. Removing list."), *StreamingLevel.ToString(), *Params.ConnectionManager.GetName());
+			AlwaysRelevantStreamingLevelsNeedingReplication.RemoveAtSwap(Idx, 1, false);
 		}
 		else
 		{
-			UE_LOG(LogShooterReplicationGraph, Warning, TEXT("UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection - empty RepList %s"), *Params.ConnectionManager.GetName());
+			UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING Adding always Actors on StreamingLevel %s for %s because it has at least one non dormant actor"), *StreamingLevel.ToString(), *Params.ConnectionManager.GetName());
+			Params.OutGatheredReplicationLists.AddReplicationActorList(RepList);
 		}
-
 	}
-
-#if WITH_GAMEPLAY_DEBUGGER
-	if (GameplayDebugger)
-	{
-		ReplicationActorList.ConditionalAdd(GameplayDebugger);
-	}
-#endif
 }
 
 void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::OnClientLevelVisibilityAdd(FName LevelName, UWorld* StreamingWorld)
 {
 	UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING ::OnClientLevelVisibilityAdd - %s"), *LevelName.ToString());
-	AlwaysRelevantStreamingLevelsNeedingReplication.Add(LevelName);
+	AlwaysRelevantStreamingLevelsVisible.AddUnique(LevelName);
+	AlwaysRelevantStreamingLevelsNeedingReplication.AddUnique(LevelName);
 }
 
 void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::OnClientLevelVisibilityRemove(FName LevelName)
 {
 	UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING ::OnClientLevelVisibilityRemove - %s"), *LevelName.ToString());
+	AlwaysRelevantStreamingLevelsVisible.Remove(LevelName);
 	AlwaysRelevantStreamingLevelsNeedingReplication.Remove(LevelName);
 }
 
+void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::OnStreamingLevelActorAwake(FName LevelName)
+{
+	if (AlwaysRelevantStreamingLevelsVisible.Contains(LevelName))
+	{
+		UE_CLOG(CVar_ShooterRepGraph_DisplayClientLevelStreaming > 0, LogShooterReplicationGraph, Display, TEXT("CLIENTSTREAMING ::OnStreamingLevelActorAwake - %s"), *LevelName.ToString());
+		AlwaysRelevantStreamingLevelsNeedingReplication.AddUnique(LevelName);
+	}
+}
+
 void UShooterReplicationGraphNode_AlwaysRelevant_ForConnection::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
 {
 	DebugInfo.Log(NodeName);
 	DebugInfo.PushIndent();
 	LogActorRepList(DebugInfo, NodeName, ReplicationActorList);
+	LogActorRepList(DebugInfo, TEXT("PlayerState"), PlayerStateActorList);
 
 	for (const FName& LevelName : AlwaysRelevantStreamingLevelsNeedingReplication)
 	{
@@ -762,48 +1075,183 @@ UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::UShooterReplicationGra
 	bRequiresPrepareForReplicationCall = true;
 }
 
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (ReplicationActorLists.Num() == 0 || ReplicationActorLists.Last().Num() >= TargetActorsPerFrame)
+	{
+		FActorRepListRefView& NewList = ReplicationActorLists.AddDefaulted_GetRef();
+		NewList.PrepareForWrite();
+	}
+
+	ReplicationActorLists.Last().Add(ActorInfo.Actor);
+}
+
+bool UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	// Priority lists are only rebuilt every few frames, so they must never hold on to a player state that left
+	for (auto It = PriorityLists.CreateIterator(); It; ++It)
+	{
+		It.Value().ReplicationActorList.Remove(ActorInfo.Actor);
+	}
+
+	for (int32 ListIdx = 0; ListIdx < ReplicationActorLists.Num(); ++ListIdx)
+	{
+		if (ReplicationActorLists[ListIdx].Remove(ActorInfo.Actor))
+		{
+			DefragmentLists(ListIdx);
+			return true;
+		}
+	}
+
+	UE_CLOG(bWarnIfNotFound, LogShooterReplicationGraph, Warning, TEXT("UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor - %s was not found"), *GetActorRepListTypeDebugString(ActorInfo.Actor));
+	return false;
+}
+
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyResetAllNetworkActors()
+{
+	ReplicationActorLists.Reset();
+	ForceNetUpdateReplicationActorList.Reset();
+	PriorityLists.Reset();
+}
+
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::DefragmentLists(int32 HoleListIdx)
+{
+	const int32 LastListIdx = ReplicationActorLists.Num() - 1;
+	FActorRepListRefView& LastList = ReplicationActorLists[LastListIdx];
+
+	if (HoleListIdx != LastListIdx && LastList.Num() > 0)
+	{
+		FActorRepListType MovedActor = LastList[LastList.Num() - 1];
+		LastList.Remove(MovedActor);
+		ReplicationActorLists[HoleListIdx].Add(MovedActor);
+	}
+
+	if (LastList.Num() == 0)
+	{
+		ReplicationActorLists.RemoveAt(LastListIdx, 1, false);
+	}
+}
+
 void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
 {
 	QUICK_SCOPE_CYCLE_COUNTER( UShooterReplicationGraphNode_PlayerStateFrequencyLimiter_GlobalPrepareForReplication );
 
-	ReplicationActorLists.Reset();
 	ForceNetUpdateReplicationActorList.Reset();
 
-	ReplicationActorLists.AddDefaulted();
-	FActorRepListRefView* CurrentList = &ReplicationActorLists[0];
-	CurrentList->PrepareForWrite();
+	// Connections that went away leave their priority list behind, clean those up once in a while
+	if (GFrameCounter % PriorityListRebuildPeriodFrame == 0)
+	{
+		for (auto It = PriorityLists.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
 
-	// We rebuild our lists of player states each frame. This is not as efficient as it could be but its the simplest way
-	// to handle players disconnecting and keeping the lists compact. If the lists were persistent we would need to defrag them as players left.
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::BuildPriorityList(const FConnectionGatherActorListParameters& Params, FActorRepListRefView& PriorityList) const
+{
+	PriorityList.Reset();
+	PriorityList.PrepareForWrite();
+
+	const AShooterGameState* GameState = GetWorld()->GetGameState<AShooterGameState>();
+	const bool bTeamGame = GameState && GameState->NumTeams > 1;
 
-	for (TActorIterator<APlayerState> It(GetWorld()); It; ++It)
+	int32 ViewerTeamNum = INDEX_NONE;
+	TArray<const APlayerState*, TInlineAllocator<4>> ViewerPlayerStates;
+	for (const FNetViewer& CurViewer : Params.Viewers)
 	{
-		APlayerState* PS = *It;
-		if (IsActorValidForReplicationGather(PS) == false)
+		if (const APlayerController* PC = Cast<APlayerController>(CurViewer.InViewer))
 		{
-			continue;
+			if (const AShooterPlayerState* ViewerPS = Cast<AShooterPlayerState>(PC->PlayerState))
+			{
+				ViewerPlayerStates.Add(ViewerPS);
+				ViewerTeamNum = ViewerPS->GetTeamNum();
+			}
 		}
+	}
+
+	const float PriorityDistanceSq = FMath::Square(PriorityDistance);
 
-		if (CurrentList->Num() >= TargetActorsPerFrame)
+	for (const FActorRepListRefView& List : ReplicationActorLists)
+	{
+		for (FActorRepListType Actor : List)
 		{
-			ReplicationActorLists.AddDefaulted();
-			CurrentList = &ReplicationActorLists.Last(); 
-			CurrentList->PrepareForWrite();
+			if (PriorityList.Num() >= MaxPriorityActorsPerConnection)
+			{
+				return;
+			}
+
+			// Owning players already get their own state through UShooterReplicationGraphNode_AlwaysRelevant_ForConnection
+			const AShooterPlayerState* PS = Cast<AShooterPlayerState>(Actor);
+			if (PS == nullptr || ViewerPlayerStates.Contains(PS))
+			{
+				continue;
+			}
+
+			bool bPriority = bTeamGame && PS->GetTeamNum() == ViewerTeamNum;
+			if (!bPriority)
+			{
+				if (const APawn* Pawn = PS->GetPawn())
+				{
+					const FVector PawnLocation = Pawn->GetActorLocation();
+					for (const FNetViewer& CurViewer : Params.Viewers)
+					{
+						if (FVector::DistSquared(CurViewer.ViewLocation, PawnLocation) <= PriorityDistanceSq)
+						{
+							bPriority = true;
+							break;
+						}
+					}
+				}
+			}
+
+			if (bPriority)
+			{
+				PriorityList.Add(Actor);
+			}
 		}
-		
-		CurrentList->Add(PS);
-	}	
+	}
 }
 
 void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
 {
-	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
-	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
+	if (ReplicationActorLists.Num() > 0)
+	{
+		const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
+	}
 
 	if (ForceNetUpdateReplicationActorList.Num() > 0)
 	{
 		Params.OutGatheredReplicationLists.AddReplicationActorList(ForceNetUpdateReplicationActorList);
-	}	
+	}
+
+	// Spectators have no team or position worth prioritizing, they get the rolling buckets like everyone else
+	if (UShooterReplicationGraph::IsBroadcastConnection(Params))
+	{
+		return;
+	}
+
+	// Stagger connections so they don't all rebuild or send their priority lists on the same frame
+	const uint32 StaggeredFrameNum = Params.ReplicationFrameNum + Params.ConnectionManager.ConnectionOrderNum;
+	if (PriorityReplicationPeriodFrame > 0 && StaggeredFrameNum % PriorityReplicationPeriodFrame == 0)
+	{
+		FConnectionPriorityList& PriorityList = PriorityLists.FindOrAdd(&Params.ConnectionManager);
+		if (!PriorityList.bBuilt || Params.ReplicationFrameNum - PriorityList.LastBuildFrame >= (uint32)PriorityListRebuildPeriodFrame)
+		{
+			BuildPriorityList(Params, PriorityList.ReplicationActorList);
+			PriorityList.LastBuildFrame = Params.ReplicationFrameNum;
+			PriorityList.bBuilt = true;
+		}
+
+		if (PriorityList.ReplicationActorList.Num() > 0)
+		{
+			Params.OutGatheredReplicationLists.AddReplicationActorList(PriorityList.ReplicationActorList);
+		}
+	}
 }
 
 void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
@@ -817,11 +1265,77 @@ void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicat
 		LogActorRepList(DebugInfo, FString::Printf(TEXT("Bucket[%d]"), i++), List);
 	}
 
+	for (const auto& It : PriorityLists)
+	{
+		if (const UNetReplicationGraphConnection* ConnectionManager = It.Key.Get())
+		{
+			LogActorRepList(DebugInfo, FString::Printf(TEXT("Priority[%s]"), *ConnectionManager->GetName()), It.Value.ReplicationActorList);
+		}
+	}
+
 	DebugInfo.PopIndent();
 }
 
 // ------------------------------------------------------------------------------
 
+int32 UShooterReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	if (SharedRepBenchmark.Phase == INDEX_NONE)
+	{
+		return Super::ServerReplicateActors(DeltaSeconds);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumReplicated = Super::ServerReplicateActors(DeltaSeconds);
+	SharedRepBenchmark.Seconds[SharedRepBenchmark.Phase] += FPlatformTime::Seconds() - StartTime;
+
+	if (++SharedRepBenchmark.Frame >= SharedRepBenchmark.FramesPerPhase)
+	{
+		EndSharedRepBenchmarkPhase();
+	}
+
+	return NumReplicated;
+}
+
+void UShooterReplicationGraph::StartSharedRepBenchmark(int32 NumFrames)
+{
+	if (NetDriver == nullptr || SharedRepBenchmark.Phase != INDEX_NONE)
+	{
+		return;
+	}
+
+	SharedRepBenchmark = FSharedRepBenchmark();
+	SharedRepBenchmark.Phase = 0;
+	SharedRepBenchmark.FramesPerPhase = NumFrames;
+	SharedRepBenchmark.PhaseStartBytes = NetDriver->OutTotalBytes;
+	SharedRepBenchmark.bFastPathWasEnabled = UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.EnableFastPath;
+
+	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.EnableFastPath = true;
+}
+
+void UShooterReplicationGraph::EndSharedRepBenchmarkPhase()
+{
+	// the bunches of the phase's last frame are flushed after it, both phases miss one frame of bytes alike
+	SharedRepBenchmark.Bytes[SharedRepBenchmark.Phase] = NetDriver->OutTotalBytes - SharedRepBenchmark.PhaseStartBytes;
+	SharedRepBenchmark.PhaseStartBytes = NetDriver->OutTotalBytes;
+	SharedRepBenchmark.Frame = 0;
+
+	if (SharedRepBenchmark.Phase == 0)
+	{
+		SharedRepBenchmark.Phase = 1;
+		UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.EnableFastPath = false;
+		return;
+	}
+
+	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.EnableFastPath = SharedRepBenchmark.bFastPathWasEnabled;
+	SharedRepBenchmark.Phase = INDEX_NONE;
+
+	const int32 NumFrames = SharedRepBenchmark.FramesPerPhase;
+	UE_LOG(LogShooterReplicationGraph, Display, TEXT("BenchmarkSharedRep: %d connections, %d frames per run"), Connections.Num(), NumFrames);
+	UE_LOG(LogShooterReplicationGraph, Display, TEXT("  fast shared path:    %.4f ms, %.1f bytes per frame"), SharedRepBenchmark.Seconds[0] * 1000.0 / NumFrames, (double)SharedRepBenchmark.Bytes[0] / NumFrames);
+	UE_LOG(LogShooterReplicationGraph, Display, TEXT("  properties only:     %.4f ms, %.1f bytes per frame"), SharedRepBenchmark.Seconds[1] * 1000.0 / NumFrames, (double)SharedRepBenchmark.Bytes[1] / NumFrames);
+}
+
 void UShooterReplicationGraph::PrintRepNodePolicies()
 {
 	UEnum* Enum = StaticEnum<EClassRepNodeMapping>();
@@ -856,6 +1370,24 @@ FAutoConsoleCommandWithWorldAndArgs ShooterPrintRepNodePoliciesCmd(TEXT("Shooter
 
 // ------------------------------------------------------------------------------
 
+FAutoConsoleCommandWithWorldAndArgs ShooterBenchmarkSharedRepCmd(TEXT("ShooterRepGraph.BenchmarkSharedRep"), TEXT("Replicates NumFrames frames with the fast shared path and NumFrames without it, then logs the replication time and bytes sent of both. Args: NumFrames (default 300)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		int32 NumFrames = 300;
+		if (Args.Num() > 0)
+		{
+			LexTryParseString<int32>(NumFrames, *Args[0]);
+		}
+
+		for (TObjectIterator<UShooterReplicationGraph> It; It; ++It)
+		{
+			It->StartSharedRepBenchmark(FMath::Max(NumFrames, 1));
+		}
+	})
+);
+
+// ------------------------------------------------------------------------------
+
 FAutoConsoleCommandWithWorldAndArgs ChangeFrequencyBucketsCmd(TEXT("ShooterRepGraph.FrequencyBuckets"), TEXT("Resets frequency bucket count."), FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World) 
 {
 	int32 Buckets = 1;
@@ -10,6 +10,9 @@ class AShooterCharacter;
 class AShooterWeapon;
 class UReplicationGraphNode_GridSpatialization2D;
 class AGameplayDebuggerCategoryReplicator;
+class UShooterReplicationGraphNode_PlayerStateFrequencyLimiter;
+class UShooterReplicationGraphNode_AlwaysRelevant_ForConnection;
+class UShooterReplicationGraphNode_Broadcast;
 
 DECLARE_LOG_CATEGORY_EXTERN( LogShooterReplicationGraph, Display, All );
 
@@ -17,8 +20,9 @@ DECLARE_LOG_CATEGORY_EXTERN( LogShooterReplicationGraph, Display, All );
 UENUM()
 enum class EClassRepNodeMapping : uint32
 {
-	NotRouted,						// Doesn't map to any node. Used for special case actors that handled by special case nodes (UShooterReplicationGraphNode_PlayerStateFrequencyLimiter)
+	NotRouted,						// Doesn't map to any node. Used for special case actors that handled by special case nodes (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection)
 	RelevantAllConnections,			// Routes to an AlwaysRelevantNode or AlwaysRelevantStreamingLevelNode node
+	PlayerStateFrequencyLimited,	// Routes to the PlayerStateNode (UShooterReplicationGraphNode_PlayerStateFrequencyLimiter)
 	
 	// ONLY SPATIALIZED Enums below here! See UShooterReplicationGraph::IsSpatialized
 
@@ -27,6 +31,26 @@ enum class EClassRepNodeMapping : uint32
 	Spatialize_Dormancy,			// Routes to GridNode: While dormant we treat as static. When flushed/not dormant dynamic. Note this is for things that "move while not dormant".
 };
 
+/** Spatial grid settings for one map, anything left at 0 is derived from the map when it loads */
+USTRUCT()
+struct FShooterRepGraphMapSettings
+{
+	GENERATED_BODY()
+
+	/** short name of the map, e.g. Highrise */
+	UPROPERTY(config)
+	FString MapName;
+
+	UPROPERTY(config)
+	float CellSize = 0.f;
+
+	UPROPERTY(config)
+	bool bOverrideSpatialBias = false;
+
+	UPROPERTY(config)
+	FVector2D SpatialBias = FVector2D::ZeroVector;
+};
+
 /** ShooterGame Replication Graph implementation. See additional notes in ShooterReplicationGraph.cpp! */
 UCLASS(transient, config=Engine)
 class UShooterReplicationGraph :public UReplicationGraph
@@ -41,13 +65,43 @@ public:
 
 	virtual void InitGlobalActorClassSettings() override;
 	virtual void InitGlobalGraphNodes() override;
+	virtual void InitializeForWorld(UWorld* World) override;
 	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
 	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
 	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	/** Replicate NumFrames frames with the fast shared path, then NumFrames without it, and log the time spent in ServerReplicateActors and the bytes sent by both runs */
+	void StartSharedRepBenchmark(int32 NumFrames);
 	
 	UPROPERTY()
 	TArray<UClass*>	SpatializedClasses;
 
+	/** Per map overrides of the derived grid settings */
+	UPROPERTY(config)
+	TArray<FShooterRepGraphMapSettings> MapGridSettings;
+
+	/** Spatialized classes that rebuild the grid when they leave it. Everything else is clamped to the edge cells. */
+	UPROPERTY(config)
+	TArray<TSubclassOf<AActor>> SpatialRebuildClasses;
+
+	/** Derived cell size aims for about this many spatialized actors per cell */
+	UPROPERTY(config)
+	float TargetActorsPerCell;
+
+	UPROPERTY(config)
+	float MinCellSize;
+
+	UPROPERTY(config)
+	float MaxCellSize;
+
+	/**
+	 * Broadcast (spectator only) connections get the shared spectator list every this many frames, all on the same frame.
+	 * Clamped to 1 less than the actor channel frame timeout (4 for pawns), or the channels would close between updates.
+	 */
+	UPROPERTY(config)
+	int32 SpectatorReplicationPeriodFrame;
+
 	UPROPERTY()
 	TArray<UClass*> NonSpatializedChildClasses;
 
@@ -60,8 +114,23 @@ public:
 	UPROPERTY()
 	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
 
+	UPROPERTY()
+	UShooterReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode;
+
+	UPROPERTY()
+	UShooterReplicationGraphNode_Broadcast* BroadcastNode;
+
 	TMap<FName, FActorRepListRefView> AlwaysRelevantStreamingLevelActors;
 
+	/** Number of actors in AlwaysRelevantStreamingLevelActors that are not dormant, per level. Maintained from dormancy change events. */
+	TMap<FName, int32> AlwaysRelevantStreamingLevelNonDormantCounts;
+
+	int32 GetNumNonDormantStreamingLevelActors(FName StreamingLevelName) const
+	{
+		const int32* NumNonDormant = AlwaysRelevantStreamingLevelNonDormantCounts.Find(StreamingLevelName);
+		return NumNonDormant ? *NumNonDormant : 0;
+	}
+
 	void OnCharacterEquipWeapon(AShooterCharacter* Character, AShooterWeapon* NewWeapon);
 	void OnCharacterUnEquipWeapon(AShooterCharacter* Character, AShooterWeapon* OldWeapon);
 
@@ -71,15 +140,68 @@ public:
 
 	void PrintRepNodePolicies();
 
+	/** True if every viewer of the connection joined as a spectator only. These connections are fed from BroadcastNode instead of the grid. */
+	static bool IsBroadcastConnection(const FConnectionGatherActorListParameters& Params);
+
 private:
 
 	EClassRepNodeMapping GetMappingPolicy(UClass* Class);
 
+	/** Sets the grid's cell size and bias from the world's level bounds and actor density, or from MapGridSettings */
+	void ConfigureGridForWorld(UWorld* World);
+
+	UShooterReplicationGraphNode_AlwaysRelevant_ForConnection* GetAlwaysRelevantNodeForConnection(UNetConnection* NetConnection);
+
+	void OnAlwaysRelevantStreamingActorDormancyChange(FActorRepListType Actor, FGlobalActorReplicationInfo& GlobalInfo, ENetDormancy NewValue, ENetDormancy OldValue);
+
 	bool IsSpatialized(EClassRepNodeMapping Mapping) const { return Mapping >= EClassRepNodeMapping::Spatialize_Static; }
 
 	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
+
+	/** State of a running StartSharedRepBenchmark. Phase 0 runs with the fast shared path, 1 without it, INDEX_NONE when no benchmark runs. */
+	struct FSharedRepBenchmark
+	{
+		int32 Phase = INDEX_NONE;
+		int32 FramesPerPhase = 0;
+		int32 Frame = 0;
+		double Seconds[2] = {};
+		uint32 Bytes[2] = {};
+		uint32 PhaseStartBytes = 0;
+		bool bFastPathWasEnabled = false;
+	};
+
+	FSharedRepBenchmark SharedRepBenchmark;
+
+	/** Record the bytes of the current benchmark phase, then start the next one or log the results */
+	void EndSharedRepBenchmarkPhase();
 };
 
+/** Spatial grid that skips broadcast connections, they get every spatialized actor from UShooterReplicationGraphNode_Broadcast instead */
+UCLASS()
+class UShooterReplicationGraphNode_GridSpatialization2D : public UReplicationGraphNode_GridSpatialization2D
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+};
+
+/** Every spatialized actor in one list shared by all broadcast connections. The list is maintained from add/remove notifications and returned to every spectator on the same frames, so they share the gathering and the serialization. */
+UCLASS()
+class UShooterReplicationGraphNode_Broadcast : public UReplicationGraphNode_ActorList
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	/** How often (in frames) broadcast connections get the list. Spectators see changes up to this many frames late. */
+	int32 ReplicationPeriodFrame = 2;
+};
+
+/** Connection specific always relevant actors. The list is cached and only rebuilt when the pawn, view target, player state or inventory of a viewer changes. */
 UCLASS()
 class UShooterReplicationGraphNode_AlwaysRelevant_ForConnection : public UReplicationGraphNode
 {
@@ -98,6 +220,12 @@ public:
 	void OnClientLevelVisibilityAdd(FName LevelName, UWorld* StreamingWorld);
 	void OnClientLevelVisibilityRemove(FName LevelName);
 
+	/** Called when an always relevant actor of a streaming level comes out of dormancy */
+	void OnStreamingLevelActorAwake(FName LevelName);
+
+	/** Forces the cached list to be rebuilt on the next gather (equip/unequip, debugger owner change) */
+	void MarkActorListDirty() { bActorListDirty = true; }
+
 	void ResetGameWorldState();
 
 #if WITH_GAMEPLAY_DEBUGGER
@@ -106,18 +234,35 @@ public:
 
 private:
 
+	/** Returns true if a viewer's pawn, view target, player state or inventory changed since the list was built */
+	bool HaveViewersChanged(const FConnectionGatherActorListParameters& Params) const;
+
+	void RebuildActorList(const FConnectionGatherActorListParameters& Params);
+
+	/** Streaming levels the client has visible */
+	TArray<FName, TInlineAllocator<64> > AlwaysRelevantStreamingLevelsVisible;
+
+	/** Visible streaming levels that still have always relevant actors to send to this connection */
 	TArray<FName, TInlineAllocator<64> > AlwaysRelevantStreamingLevelsNeedingReplication;
 
 	FActorRepListRefView ReplicationActorList;
 
-	UPROPERTY()
-	AActor* LastPawn = nullptr;
+	/** The owning player's state. Kept apart from ReplicationActorList because it is throttled. */
+	FActorRepListRefView PlayerStateActorList;
 
-	/** List of previously (or currently if nothing changed last tick) focused actor data per connection */
-	UPROPERTY()
-	TArray<FAlwaysRelevantActorInfo> PastRelevantActors;
+	/** What ReplicationActorList was built from */
+	struct FCachedViewer
+	{
+		TWeakObjectPtr<AActor> InViewer;
+		TWeakObjectPtr<AActor> ViewTarget;
+		TWeakObjectPtr<APawn> Pawn;
+		TWeakObjectPtr<APlayerState> PlayerState;
+		int32 InventoryCount = 0;
+	};
+
+	TArray<FCachedViewer, TInlineAllocator<2> > CachedViewers;
 
-	bool bInitializedPlayerState = false;
+	bool bActorListDirty = true;
 };
 
 /** This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame. */
@@ -128,8 +273,9 @@ class UShooterReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplica
 
 	UShooterReplicationGraphNode_PlayerStateFrequencyLimiter();
 
-	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
-	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override { return false; }
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override;
+	virtual void NotifyResetAllNetworkActors() override;
 
 	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
 
@@ -140,8 +286,37 @@ class UShooterReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplica
 	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
 	int32 TargetActorsPerFrame = 2;
 
+	/** How often (in frames) a connection gets the player states of its teammates and nearby players, on top of the rolling buckets. */
+	int32 PriorityReplicationPeriodFrame = 4;
+
+	/** How often (in frames) a connection's priority list is rebuilt. */
+	int32 PriorityListRebuildPeriodFrame = 30;
+
+	/** Players whose pawn is closer than this to a viewer are prioritized for that connection. */
+	float PriorityDistance = 5000.f;
+
+	/** Max number of prioritized player states per connection. */
+	int32 MaxPriorityActorsPerConnection = 8;
+
 private:
-	
+
+	/** Moves the most recently added player state into the hole left in the given bucket, so only the last bucket is ever partially filled */
+	void DefragmentLists(int32 HoleListIdx);
+
+	/** Rebuilds the list of teammates and nearby players for a connection */
+	void BuildPriorityList(const FConnectionGatherActorListParameters& Params, FActorRepListRefView& PriorityList) const;
+
+	/** Persistent buckets of player states. Every bucket but the last one holds exactly TargetActorsPerFrame actors. */
 	TArray<FActorRepListRefView> ReplicationActorLists;
 	FActorRepListRefView ForceNetUpdateReplicationActorList;
+
+	struct FConnectionPriorityList
+	{
+		FActorRepListRefView ReplicationActorList;
+		uint32 LastBuildFrame = 0;
+		bool bBuilt = false;
+	};
+
+	/** Teammates and nearby players per connection */
+	TMap<TWeakObjectPtr<UNetReplicationGraphConnection>, FConnectionPriorityList> PriorityLists;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterPickupRegistry.h"
 #include "Particles/ParticleSystemComponent.h"
 
 AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -50,9 +51,24 @@ void AShooterPickup::BeginPlay()
 	if (GameMode)
 	{
 		GameMode->LevelPickups.Add(this);
+
+		if (UShooterPickupRegistry* Registry = UShooterPickupRegistry::Get(this))
+		{
+			Registry->RegisterPickup(this);
+		}
 	}
 }
 
+void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UShooterPickupRegistry* Registry = UShooterPickupRegistry::Get(this))
+	{
+		Registry->UnregisterPickup(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AShooterPickup::NotifyActorBeginOverlap(class AActor* Other)
 {
 	Super::NotifyActorBeginOverlap(Other);
@@ -97,6 +113,11 @@ void AShooterPickup::RespawnPickup()
 	PickedUpBy = NULL;
 	OnRespawned();
 
+	if (UShooterPickupRegistry* Registry = UShooterPickupRegistry::Get(this))
+	{
+		Registry->SetPickupActive(this, true);
+	}
+
 	TSet<AActor*> OverlappingPawns;
 	GetOverlappingActors(OverlappingPawns, AShooterCharacter::StaticClass());
 
@@ -118,6 +139,12 @@ void AShooterPickup::OnPickedUp()
 		PickupPSC->DeactivateSystem();
 	}
 
+	// clients never register, so this only matters on the server
+	if (UShooterPickupRegistry* Registry = UShooterPickupRegistry::Get(this))
+	{
+		Registry->SetPickupActive(this, false);
+	}
+
 	if (Mesh)
 	{
 		Mesh->SetActive(false);
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Pickups/ShooterPickup.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Registry Query"), STAT_ShooterPickupRegistryQuery, STATGROUP_Shooter);
+
+/** pickups are sparse, big cells keep the ring walk short */
+static const float PickupCellSize = 2000.f;
+
+UShooterPickupRegistry* UShooterPickupRegistry::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UShooterPickupRegistry>() : nullptr;
+}
+
+void UShooterPickupRegistry::RegisterPickup(AShooterPickup* Pickup)
+{
+	if (Pickup == nullptr || PickupIndices.Contains(Pickup))
+	{
+		return;
+	}
+
+	UClass* PickupClass = Pickup->GetClass();
+	UClass* WeaponClass = Pickup->GetWeaponType();
+
+	int32 BucketIndex = Buckets.IndexOfByPredicate([&](const FBucket& Bucket)
+	{
+		return Bucket.PickupClass == PickupClass && Bucket.WeaponClass == WeaponClass;
+	});
+
+	if (BucketIndex == INDEX_NONE)
+	{
+		BucketIndex = Buckets.AddDefaulted();
+		Buckets[BucketIndex].PickupClass = PickupClass;
+		Buckets[BucketIndex].WeaponClass = WeaponClass;
+	}
+
+	FBucket& Bucket = Buckets[BucketIndex];
+	const FVector Location = Pickup->GetActorLocation();
+	const FIntPoint Cell = GetCell(Location);
+
+	const int32 EntryIndex = Bucket.Entries.Add({ Pickup, Location, Pickup->IsActive() });
+	Bucket.Cells.FindOrAdd(Cell).Add(EntryIndex);
+
+	Bucket.MinCell.X = FMath::Min(Bucket.MinCell.X, Cell.X);
+	Bucket.MinCell.Y = FMath::Min(Bucket.MinCell.Y, Cell.Y);
+	Bucket.MaxCell.X = FMath::Max(Bucket.MaxCell.X, Cell.X);
+	Bucket.MaxCell.Y = FMath::Max(Bucket.MaxCell.Y, Cell.Y);
+
+	PickupIndices.Add(Pickup, FIntPoint(BucketIndex, EntryIndex));
+}
+
+void UShooterPickupRegistry::UnregisterPickup(AShooterPickup* Pickup)
+{
+	FIntPoint Index;
+	if (PickupIndices.RemoveAndCopyValue(Pickup, Index))
+	{
+		FEntry& Entry = Buckets[Index.X].Entries[Index.Y];
+		Entry.Pickup = nullptr;
+		Entry.bActive = false;
+	}
+}
+
+void UShooterPickupRegistry::SetPickupActive(AShooterPickup* Pickup, bool bActive)
+{
+	if (const FIntPoint* Index = PickupIndices.Find(Pickup))
+	{
+		Buckets[Index->X].Entries[Index->Y].bActive = bActive;
+	}
+}
+
+void UShooterPickupRegistry::FindNearestPickups(UClass* PickupClass, UClass* WeaponClass, const FVector& Origin, int32 MaxResults, TFunctionRef<bool(AShooterPickup*)> Predicate, TArray<AShooterPickup*>& OutPickups) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPickupRegistryQuery);
+
+	OutPickups.Reset();
+	if (MaxResults <= 0)
+	{
+		return;
+	}
+
+	TArray<FCandidate, TInlineAllocator<8>> Candidates;
+	for (const FBucket& Bucket : Buckets)
+	{
+		if (Bucket.PickupClass->IsChildOf(PickupClass) && (WeaponClass == nullptr || (Bucket.WeaponClass && Bucket.WeaponClass->IsChildOf(WeaponClass))))
+		{
+			TArray<FCandidate> BucketCandidates;
+			GatherNearest(Bucket, Origin, MaxResults, Predicate, BucketCandidates);
+			Candidates.Append(BucketCandidates);
+		}
+	}
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+	for (int32 i = 0; i < Candidates.Num() && i < MaxResults; i++)
+	{
+		OutPickups.Add(Candidates[i].Pickup);
+	}
+}
+
+void UShooterPickupRegistry::GatherNearest(const FBucket& Bucket, const FVector& Origin, int32 MaxResults, TFunctionRef<bool(AShooterPickup*)> Predicate, TArray<FCandidate>& OutCandidates) const
+{
+	if (Bucket.Cells.Num() == 0)
+	{
+		return;
+	}
+
+	auto CandidateLess = [](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; };
+
+	// active pickups found so far, a heap ordered by distance
+	TArray<FCandidate, TInlineAllocator<16>> Pending;
+
+	const FIntPoint Center = GetCell(Origin);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(Bucket.MinCell.X - Center.X), FMath::Abs(Bucket.MaxCell.X - Center.X)),
+		FMath::Max(FMath::Abs(Bucket.MinCell.Y - Center.Y), FMath::Abs(Bucket.MaxCell.Y - Center.Y)));
+
+	for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		// gather the cells on the border of the square, the inside was done by the previous rings
+		for (int32 Y = Center.Y - Ring; Y <= Center.Y + Ring; Y++)
+		{
+			const bool bEdgeRow = FMath::Abs(Y - Center.Y) == Ring;
+			const int32 XStep = bEdgeRow ? 1 : 2 * Ring;
+			for (int32 X = Center.X - Ring; X <= Center.X + Ring; X += XStep)
+			{
+				const TArray<int32>* Cell = Bucket.Cells.Find(FIntPoint(X, Y));
+				if (Cell == nullptr)
+				{
+					continue;
+				}
+
+				for (const int32 Index : *Cell)
+				{
+					const FEntry& Entry = Bucket.Entries[Index];
+					if (Entry.bActive && Entry.Pickup)
+					{
+						Pending.HeapPush({ Entry.Pickup, FVector::DistSquared(Entry.Location, Origin) }, CandidateLess);
+					}
+				}
+			}
+		}
+
+		// everything within Ring cells of the center has been gathered, so candidates closer than that are final
+		const float SafeDistSq = FMath::Square(Ring * PickupCellSize);
+		while (Pending.Num() > 0 && (Pending.HeapTop().DistSq <= SafeDistSq || Ring == MaxRing))
+		{
+			FCandidate Candidate;
+			Pending.HeapPop(Candidate, CandidateLess, false);
+
+			if (Predicate(Candidate.Pickup))
+			{
+				OutCandidates.Add(Candidate);
+				if (OutCandidates.Num() >= MaxResults)
+				{
+					return;
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UShooterPickupRegistry::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / PickupCellSize), FMath::FloorToInt(Location.Y / PickupCellSize));
+}
+
+void UShooterPickupRegistry::Deinitialize()
+{
+	Buckets.Empty();
+	PickupIndices.Empty();
+
+	Super::Deinitialize();
+}
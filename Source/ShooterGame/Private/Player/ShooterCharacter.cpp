@@ -9,12 +9,13 @@
 #include "Animation/AnimMontage.h"
 #include "Animation/AnimInstance.h"
 #include "Sound/SoundNodeLocalPlayer.h"
-#include "AudioThread.h"
 #include "ShooterCharacterMovement.h"
 #include "Math/UnrealMathUtility.h"
 #include "Runtime/Engine/Classes/Components/TimelineComponent.h"
 #include "..\..\Public\Player\ShooterCharacter.h"
 
+DECLARE_CYCLE_STAT(TEXT("Character Shared Replication"), STAT_ShooterSharedReplication, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Server Pose Refresh"), STAT_ShooterServerPoseRefresh, STATGROUP_Shooter);
 
 static int32 NetVisualizeRelevancyTestPoints = 0;
 FAutoConsoleVariableRef CVarNetVisualizeRelevancyTestPoints(
@@ -25,6 +26,29 @@ FAutoConsoleVariableRef CVarNetVisualizeRelevancyTestPoints(
 	ECVF_Cheat);
 
 
+static float SignificanceMediumAnimTickInterval = 1.f / 30.f;
+FAutoConsoleVariableRef CVarSignificanceMediumAnimTickInterval(
+	TEXT("p.SignificanceMediumAnimTickInterval"),
+	SignificanceMediumAnimTickInterval,
+	TEXT("Tick interval (in seconds) of the 3rd person mesh of characters of medium significance"),
+	ECVF_Default);
+
+static float SignificanceLowAnimTickInterval = 0.25f;
+FAutoConsoleVariableRef CVarSignificanceLowAnimTickInterval(
+	TEXT("p.SignificanceLowAnimTickInterval"),
+	SignificanceLowAnimTickInterval,
+	TEXT("Tick interval (in seconds) of the 3rd person mesh of characters of low significance"),
+	ECVF_Default);
+
+static int32 ServerLeanCharacters = 1;
+FAutoConsoleVariableRef CVarServerLeanCharacters(
+	TEXT("p.ServerLeanCharacters"),
+	ServerLeanCharacters,
+	TEXT("On dedicated servers, strip the cosmetic components of characters and weapons as they spawn, use the capsule as hitbox\n")
+	TEXT("and only evaluate the 3rd person pose when a shot needs it.\n")
+	TEXT("0: Disable, 1: Enable"),
+	ECVF_Default);
+
 static int32 NetEnablePauseRelevancy = 1;
 FAutoConsoleVariableRef CVarNetEnablePauseRelevancy(
 	TEXT("p.NetEnablePauseRelevancy"),
@@ -33,6 +57,22 @@ FAutoConsoleVariableRef CVarNetEnablePauseRelevancy(
 	TEXT("0: Disable, 1: Enable"),
 	ECVF_Cheat);
 
+static float NetPauseRelevancyMaxStaleness = 0.1f;
+FAutoConsoleVariableRef CVarNetPauseRelevancyMaxStaleness(
+	TEXT("p.NetPauseRelevancyMaxStaleness"),
+	NetPauseRelevancyMaxStaleness,
+	TEXT("How long (in seconds) a pause relevancy visibility result is reused before its traces are issued again.\n")
+	TEXT("0: refresh every frame"),
+	ECVF_Default);
+
+static int32 NetPauseRelevancyAsyncTraces = 1;
+FAutoConsoleVariableRef CVarNetPauseRelevancyAsyncTraces(
+	TEXT("p.NetPauseRelevancyAsyncTraces"),
+	NetPauseRelevancyAsyncTraces,
+	TEXT("Run the pause relevancy visibility traces asynchronously. Results are then one frame behind.\n")
+	TEXT("0: Disable, 1: Enable"),
+	ECVF_Default);
+
 FOnShooterCharacterEquipWeapon AShooterCharacter::NotifyEquipWeapon;
 FOnShooterCharacterUnEquipWeapon AShooterCharacter::NotifyUnEquipWeapon;
 
@@ -72,10 +112,14 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	bWantsToRun = false;
 	bWantsToFire = false;
 	LowHealthPercentage = 0.5f;
+	LeanHitboxPadding = 20.f;
 
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
 
+	LastPauseReplicationPruneTime = 0.f;
+	PauseReplicationTraceDelegate.BindUObject(this, &AShooterCharacter::OnPauseReplicationTraceDone);
+
 	//WallRunning = false;
 
 	//ResetJump(MaxJumps);
@@ -94,13 +138,21 @@ void AShooterCharacter::PostInitializeComponents()
 		GetWorldTimerManager().SetTimerForNextTick(this, &AShooterCharacter::SpawnDefaultInventory);
 	}
 
+	if (ShouldBeServerLean(this))
+	{
+		MakeServerLean();
+	}
+
 	// set initial mesh visibility (3rd person view)
 	UpdatePawnMeshes();
 
-	// create material instance for setting team colors (3rd person view)
-	for (int32 iMat = 0; iMat < GetMesh()->GetNumMaterials(); iMat++)
+	// create material instance for setting team colors (3rd person view), nobody sees them on lean servers
+	if (!bServerLean)
 	{
-		MeshMIDs.Add(GetMesh()->CreateAndSetMaterialInstanceDynamic(iMat));
+		for (int32 iMat = 0; iMat < GetMesh()->GetNumMaterials(); iMat++)
+		{
+			MeshMIDs.Add(GetMesh()->CreateAndSetMaterialInstanceDynamic(iMat));
+		}
 	}
 
 	// play respawn effects
@@ -195,6 +247,12 @@ bool AShooterCharacter::IsEnemyFor(AController* TestPC) const
 
 void AShooterCharacter::UpdatePawnMeshes()
 {
+	// MakeServerLean set the tick options for good
+	if (bServerLean)
+	{
+		return;
+	}
+
 	bool const bFirstPerson = IsFirstPerson();
 
 	Mesh1P->VisibilityBasedAnimTickOption = !bFirstPerson ? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
@@ -287,6 +345,18 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 	const float ActualDamage = Super::TakeDamage(Damage, DamageEvent, EventInstigator, DamageCauser);
 	if (ActualDamage > 0.f)
 	{
+		// counted for every hit here, LastTakeHitInfo only keeps the last hit of a frame
+		AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(GetPlayerState());
+		AShooterPlayerState* InstigatorPlayerState = EventInstigator ? Cast<AShooterPlayerState>(EventInstigator->PlayerState) : nullptr;
+		if (MyPlayerState)
+		{
+			MyPlayerState->ScoreDamageTaken(ActualDamage);
+		}
+		if (InstigatorPlayerState && InstigatorPlayerState != MyPlayerState)
+		{
+			InstigatorPlayerState->ScoreHit(ActualDamage);
+		}
+
 		Health -= ActualDamage;
 		if (Health <= 0)
 		{
@@ -412,7 +482,7 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 		RunLoopAC->Stop();
 	}
 
-	if (GetMesh())
+	if (GetMesh() && !bServerLean)
 	{
 		static FName CollisionProfileName(TEXT("Ragdoll"));
 		GetMesh()->SetCollisionProfileName(CollisionProfileName);
@@ -502,6 +572,11 @@ void AShooterCharacter::SetRagdollPhysics()
 	{
 		bInRagdoll = false;
 	}
+	else if (bServerLean)
+	{
+		// nobody sees the ragdoll on a lean server, keep the body around as long as the clients show theirs without simulating it
+		bInRagdoll = true;
+	}
 	else
 	{
 		// initialize physics/etc
@@ -1181,7 +1256,9 @@ void AShooterCharacter::Tick(float DeltaSeconds)
 		}
 	}
 
-	if (GEngine->UseSound())
+	// cosmetic work, nobody sees or hears it on dedicated servers or for characters far away or out of sight
+	const bool bCosmetic = GetNetMode() != NM_DedicatedServer && Significance != EShooterSignificance::Low;
+	if (bCosmetic && GEngine->UseSound())
 	{
 		if (LowHealthSound)
 		{
@@ -1209,19 +1286,23 @@ void AShooterCharacter::Tick(float DeltaSeconds)
 		UpdateRunSounds();
 	}
 
-	const APlayerController* PC = Cast<APlayerController>(GetController());
-	const bool bLocallyControlled = (PC ? PC->IsLocalController() : false);
-	const uint32 UniqueID = GetUniqueID();
-	FAudioThread::RunCommandOnAudioThread([UniqueID, bLocallyControlled]()
-		{
-			USoundNodeLocalPlayer::GetLocallyControlledActorCache().Add(UniqueID, bLocallyControlled);
-		});
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		const APlayerController* PC = Cast<APlayerController>(GetController());
+		const bool bLocallyControlled = (PC ? PC->IsLocalController() : false);
+		USoundNodeLocalPlayer::SetLocallyControlled(GetUniqueID(), bLocallyControlled);
+	}
 
-	TArray<FVector> PointsToTest;
-	BuildPauseReplicationCheckPoints(PointsToTest);
+	if (GetLocalRole() == ROLE_Authority && GetNetMode() != NM_Standalone)
+	{
+		RecordRewindHistory();
+	}
 
 	if (NetVisualizeRelevancyTestPoints == 1)
 	{
+		FPauseReplicationCheckPoints PointsToTest;
+		BuildPauseReplicationCheckPoints(PointsToTest);
+
 		for (FVector PointToTest : PointsToTest)
 		{
 			DrawDebugSphere(GetWorld(), PointToTest, 10.0f, 8, FColor::Red);
@@ -1233,6 +1314,69 @@ void AShooterCharacter::Tick(float DeltaSeconds)
 	CameraTiltTimeline.TickTimeline(DeltaSeconds);*/
 }
 
+void AShooterCharacter::RecordRewindHistory()
+{
+	const UCapsuleComponent* Capsule = GetCapsuleComponent();
+	const FVector CapsuleLocation = Capsule->GetComponentLocation();
+	if (bServerLean)
+	{
+		// the pose of the mesh is stale on lean servers, the padded capsule is the hitbox proxy
+		const float Radius = Capsule->GetScaledCapsuleRadius() + LeanHitboxPadding;
+		const FVector Extent(Radius, Radius, Capsule->GetScaledCapsuleHalfHeight() + LeanHitboxPadding);
+		RewindHistory.Record(GetWorld()->GetTimeSeconds(), CapsuleLocation, FBoxSphereBounds(CapsuleLocation, Extent, Extent.Size()));
+	}
+	else
+	{
+		// the 3rd person mesh is what weapon traces hit, its cached bounds stand in for the hitboxes
+		RewindHistory.Record(GetWorld()->GetTimeSeconds(), CapsuleLocation, GetMesh()->Bounds);
+	}
+}
+
+bool AShooterCharacter::ShouldBeServerLean(const AActor* Actor)
+{
+	return ServerLeanCharacters != 0 && Actor->GetNetMode() == NM_DedicatedServer;
+}
+
+void AShooterCharacter::MakeServerLean()
+{
+	bServerLean = true;
+
+	// the weapons still attach to the 1st person mesh, keep the component but drop its mesh, animation and tick.
+	// component ticks are only registered in BeginPlay, which turns them back on unless they don't start enabled
+	Mesh1P->SetSkeletalMesh(nullptr);
+	Mesh1P->PrimaryComponentTick.bStartWithTickEnabled = false;
+	Mesh1P->SetComponentTickEnabled(false);
+
+	// the 3rd person mesh only animates in RefreshServerPose, montages included, and the capsule takes the hits in its place
+	GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	GetMesh()->PrimaryComponentTick.bStartWithTickEnabled = false;
+	GetMesh()->SetComponentTickEnabled(false);
+	GetMesh()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	GetCapsuleComponent()->SetCollisionResponseToChannel(COLLISION_WEAPON, ECR_Block);
+	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+
+	LastServerPoseTime = GetWorld()->GetTimeSeconds();
+}
+
+void AShooterCharacter::RefreshServerPose()
+{
+	if (!bServerLean || LastServerPoseFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterServerPoseRefresh);
+
+	// catch up on all the animation time since the last refresh in one step
+	const float Now = GetWorld()->GetTimeSeconds();
+	GetMesh()->TickAnimation((Now - LastServerPoseTime) * CustomTimeDilation, false);
+	GetMesh()->RefreshBoneTransforms();
+
+	LastServerPoseTime = Now;
+	LastServerPoseFrame = GFrameCounter;
+}
+
 void AShooterCharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -1262,11 +1406,7 @@ void AShooterCharacter::BeginDestroy()
 
 	if (!GExitPurge)
 	{
-		const uint32 UniqueID = GetUniqueID();
-		FAudioThread::RunCommandOnAudioThread([UniqueID]()
-			{
-				USoundNodeLocalPlayer::GetLocallyControlledActorCache().Remove(UniqueID);
-			});
+		USoundNodeLocalPlayer::RemoveActor(GetUniqueID());
 	}
 }
 
@@ -1537,6 +1677,116 @@ void AShooterCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >&
 	DOREPLIFETIME(AShooterCharacter, Health);
 }
 
+bool AShooterCharacter::UpdateSharedReplication()
+{
+	if (GetLocalRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterSharedReplication);
+
+	FShooterSharedRepMovement SharedMovement;
+	if (!SharedMovement.FillForCharacter(this))
+	{
+		return false;
+	}
+
+	// when nothing changed the graph reuses last frame's bunch: connections that already got it are skipped, new ones still get it
+	if (!SharedMovement.Equals(LastSharedReplication))
+	{
+		LastSharedReplication = SharedMovement;
+		ReplicatedMovementMode = SharedMovement.RepMovementMode;
+		FastSharedReplication(SharedMovement);
+	}
+
+	return true;
+}
+
+void AShooterCharacter::FastSharedReplication_Implementation(const FShooterSharedRepMovement& SharedRepMovement)
+{
+	if (GetLocalRole() != ROLE_SimulatedProxy || GetWorld()->IsPlayingReplay())
+	{
+		return;
+	}
+
+	ReplicatedServerLastTransformUpdateTimeStamp = SharedRepMovement.RepTimeStamp;
+
+	if (ReplicatedMovementMode != SharedRepMovement.RepMovementMode)
+	{
+		ReplicatedMovementMode = SharedRepMovement.RepMovementMode;
+		GetCharacterMovement()->bNetworkMovementModeChanged = true;
+		GetCharacterMovement()->bNetworkUpdateReceived = true;
+	}
+
+	GetReplicatedMovement_Mutable() = SharedRepMovement.RepMovement;
+	OnRep_ReplicatedMovement();
+
+	RemoteViewPitch = SharedRepMovement.RemoteViewPitch;
+}
+
+FShooterSharedRepMovement::FShooterSharedRepMovement()
+	: RepMovementMode(0)
+	, RemoteViewPitch(0)
+	, RepTimeStamp(0.f)
+{
+	RepMovement.LocationQuantizationLevel = EVectorQuantization::RoundTwoDecimals;
+}
+
+bool FShooterSharedRepMovement::FillForCharacter(ACharacter* Character)
+{
+	USceneComponent* PawnRootComponent = Character->GetRootComponent();
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	if (PawnRootComponent == nullptr || CharacterMovement == nullptr)
+	{
+		return false;
+	}
+
+	RepMovement.Location = FRepMovement::RebaseOntoZeroOrigin(PawnRootComponent->GetComponentLocation(), Character);
+	RepMovement.Rotation = PawnRootComponent->GetComponentRotation();
+	RepMovement.LinearVelocity = CharacterMovement->Velocity;
+	RepMovementMode = CharacterMovement->PackNetworkMovementMode();
+
+	// same compression as APawn::SetRemoteViewPitch, PreReplication may not have run yet this frame
+	RemoteViewPitch = Character->Controller ? (uint8)(FRotator::ClampAxis(Character->GetControlRotation().Pitch) * 255.f / 360.f) : Character->RemoteViewPitch;
+
+	const bool bSendTimeStamp = CharacterMovement->NetworkSmoothingMode == ENetworkSmoothingMode::Linear || CharacterMovement->bNetworkAlwaysReplicateTransformUpdateTimestamp;
+	RepTimeStamp = bSendTimeStamp ? CharacterMovement->GetServerLastTransformUpdateTimeStamp() : 0.f;
+
+	return true;
+}
+
+bool FShooterSharedRepMovement::Equals(const FShooterSharedRepMovement& Other) const
+{
+	// the timestamp is left out on purpose, it changes every frame
+	return RepMovement.Location == Other.RepMovement.Location
+		&& RepMovement.Rotation == Other.RepMovement.Rotation
+		&& RepMovement.LinearVelocity == Other.RepMovement.LinearVelocity
+		&& RepMovementMode == Other.RepMovementMode
+		&& RemoteViewPitch == Other.RemoteViewPitch;
+}
+
+bool FShooterSharedRepMovement::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	RepMovement.NetSerialize(Ar, Map, bOutSuccess);
+	Ar << RepMovementMode;
+	Ar << RemoteViewPitch;
+
+	uint8 bHasTimeStamp = (RepTimeStamp != 0.f);
+	Ar.SerializeBits(&bHasTimeStamp, 1);
+	if (bHasTimeStamp)
+	{
+		Ar << RepTimeStamp;
+	}
+	else
+	{
+		RepTimeStamp = 0.f;
+	}
+
+	return true;
+}
+
 bool AShooterCharacter::IsReplicationPausedForConnection(const FNetViewer& ConnectionOwnerNetViewer)
 {
 	if (NetEnablePauseRelevancy == 1)
@@ -1544,28 +1794,115 @@ bool AShooterCharacter::IsReplicationPausedForConnection(const FNetViewer& Conne
 		APlayerController* PC = Cast<APlayerController>(ConnectionOwnerNetViewer.InViewer);
 		check(PC);
 
-		FVector ViewLocation;
-		FRotator ViewRotation;
-		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		const float WorldTime = GetWorld()->GetTimeSeconds();
 
-		FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(LineOfSight), true, PC->GetPawn());
-		CollisionParams.AddIgnoredActor(this);
+		// drop viewers that went away so the cache doesn't grow over a long match
+		if (WorldTime - LastPauseReplicationPruneTime > 1.f)
+		{
+			LastPauseReplicationPruneTime = WorldTime;
+			for (auto It = PauseReplicationVisibility.CreateIterator(); It; ++It)
+			{
+				if (!It.Value().Viewer.IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
 
-		TArray<FVector> PointsToTest;
-		BuildPauseReplicationCheckPoints(PointsToTest);
+		FPauseReplicationVisibility& Visibility = PauseReplicationVisibility.FindOrAdd(PC->GetUniqueID());
+		if (Visibility.Viewer.Get() != PC)
+		{
+			// unique ids get recycled, never trust a result computed for a different controller
+			Visibility = FPauseReplicationVisibility();
+			Visibility.Viewer = PC;
+		}
 
-		for (FVector PointToTest : PointsToTest)
+		// every node asking about this viewer during the same frame gets the same answer
+		if (Visibility.LastQueryFrame == GFrameCounter)
+		{
+			return Visibility.bPaused;
+		}
+		Visibility.LastQueryFrame = GFrameCounter;
+
+		// async results come back at the start of the next frame, anything older than that was lost (e.g. world reset)
+		const bool bBatchInFlight = Visibility.PendingTraceCount > 0 && (GFrameCounter - Visibility.PendingIssueFrame) <= 2;
+		const bool bResultIsStale = !Visibility.bHasResult || (WorldTime - Visibility.LastResultTime) > NetPauseRelevancyMaxStaleness;
+		if (bResultIsStale && !bBatchInFlight)
+		{
+			UpdatePauseReplicationVisibility(PC, Visibility);
+		}
+
+		// until the first result is in, keep replicating
+		return Visibility.bPaused;
+	}
+
+	return false;
+}
+
+void AShooterCharacter::UpdatePauseReplicationVisibility(APlayerController* Viewer, FPauseReplicationVisibility& Visibility)
+{
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Viewer->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(LineOfSight), true, Viewer->GetPawn());
+	CollisionParams.AddIgnoredActor(this);
+
+	FPauseReplicationCheckPoints PointsToTest;
+	BuildPauseReplicationCheckPoints(PointsToTest);
+
+	if (NetPauseRelevancyAsyncTraces == 0)
+	{
+		bool bAnyVisible = false;
+		for (const FVector& PointToTest : PointsToTest)
 		{
 			if (!GetWorld()->LineTraceTestByChannel(PointToTest, ViewLocation, ECC_Visibility, CollisionParams))
 			{
-				return false;
+				bAnyVisible = true;
+				break;
 			}
 		}
 
-		return true;
+		Visibility.PendingTraceCount = 0;
+		Visibility.bPaused = !bAnyVisible;
+		Visibility.bHasResult = true;
+		Visibility.LastResultTime = GetWorld()->GetTimeSeconds();
+		return;
 	}
 
-	return false;
+	Visibility.PendingTraceCount = PointsToTest.Num();
+	Visibility.PendingIssueFrame = GFrameCounter;
+	Visibility.bPendingAnyVisible = false;
+
+	const uint32 ViewerID = Viewer->GetUniqueID();
+	for (const FVector& PointToTest : PointsToTest)
+	{
+		GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Test, PointToTest, ViewLocation, ECC_Visibility, CollisionParams,
+			FCollisionResponseParams::DefaultResponseParam, &PauseReplicationTraceDelegate, ViewerID);
+	}
+}
+
+void AShooterCharacter::OnPauseReplicationTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FPauseReplicationVisibility* Visibility = PauseReplicationVisibility.Find(TraceDatum.UserData);
+	if (Visibility == nullptr || Visibility->PendingTraceCount <= 0)
+	{
+		return;
+	}
+
+	// test traces only report a hit when something blocks the line to the viewer
+	const bool bBlocked = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	if (!bBlocked)
+	{
+		Visibility->bPendingAnyVisible = true;
+	}
+
+	if (--Visibility->PendingTraceCount == 0)
+	{
+		Visibility->bPaused = !Visibility->bPendingAnyVisible;
+		Visibility->bHasResult = true;
+		Visibility->LastResultTime = GetWorld()->GetTimeSeconds();
+	}
 }
 
 void AShooterCharacter::OnReplicationPausedChanged(bool bIsReplicationPaused)
@@ -1645,13 +1982,61 @@ float AShooterCharacter::GetLowHealthPercentage() const
 
 void AShooterCharacter::UpdateTeamColorsAllMIDs()
 {
+	if (Significance == EShooterSignificance::Low)
+	{
+		bTeamColorsPending = true;
+		return;
+	}
+	bTeamColorsPending = false;
+
 	for (int32 i = 0; i < MeshMIDs.Num(); ++i)
 	{
 		UpdateTeamColors(MeshMIDs[i]);
 	}
 }
 
-void AShooterCharacter::BuildPauseReplicationCheckPoints(TArray<FVector>& RelevancyCheckPoints)
+void AShooterCharacter::SetSignificance(EShooterSignificance::Type NewSignificance)
+{
+	if (Significance == NewSignificance)
+	{
+		return;
+	}
+	Significance = NewSignificance;
+
+	// the server validates hits against the poses of its characters, a listen server host keeps them all fully animated
+	if (GetLocalRole() < ROLE_Authority)
+	{
+		float AnimTickInterval = 0.0f;
+		if (Significance == EShooterSignificance::Medium)
+		{
+			AnimTickInterval = SignificanceMediumAnimTickInterval;
+		}
+		else if (Significance == EShooterSignificance::Low)
+		{
+			AnimTickInterval = SignificanceLowAnimTickInterval;
+		}
+		GetMesh()->SetComponentTickInterval(AnimTickInterval);
+	}
+
+	if (Significance == EShooterSignificance::Low)
+	{
+		// Tick doesn't update the loops anymore, they start again when the character gets significant
+		if (RunLoopAC && RunLoopAC->IsActive())
+		{
+			RunLoopAC->Stop();
+		}
+		if (LowHealthWarningPlayer && LowHealthWarningPlayer->IsPlaying())
+		{
+			LowHealthWarningPlayer->Stop();
+		}
+	}
+	else if (bTeamColorsPending)
+	{
+		UpdateTeamColorsAllMIDs();
+	}
+}
+
+void AShooterCharacter::BuildPauseReplicationCheckPoints(FPauseReplicationCheckPoints& RelevancyCheckPoints)
 {
 	FBoxSphereBounds Bounds = GetCapsuleComponent()->CalcBounds(GetCapsuleComponent()->GetComponentTransform());
 	FBox BoundingBox = Bounds.GetBox();
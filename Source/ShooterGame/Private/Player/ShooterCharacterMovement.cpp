@@ -2,10 +2,36 @@
 
 #include "Player/ShooterCharacterMovement.h"
 #include "ShooterGame.h"
+#include "Player/ShooterMovementTelemetry.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/InputSettings.h"
 #include "GameFramework/PlayerController.h"
+#include "PhysicsEngine/BodySetup.h"
+
+DECLARE_CYCLE_STAT(TEXT("Wall Run Surface Check"), STAT_ShooterWallRunSurfaceCheck, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wall Run Surface Traces"), STAT_ShooterWallRunSurfaceTraces, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Server Move RPCs Received"), STAT_ShooterServerMoveRPCs, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Corrections Sent"), STAT_ShooterClientCorrections, STATGROUP_Shooter);
+
+// How far from the character the wall traces reach
+static const float WallRunTraceLength = 100.0f;
+
+#if ENABLE_DRAW_DEBUG && !UE_SERVER
+static int32 DrawWallRunTraces = 0;
+FAutoConsoleVariableRef CVarDrawWallRunTraces(
+	TEXT("p.DrawWallRunTraces"),
+	DrawWallRunTraces,
+	TEXT("Draw the traces used to check if a character is next to a wall it can run along"),
+	ECVF_Cheat);
+#endif
+
+UShooterCharacterMovement::UShooterCharacterMovement(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Send our own move data with the packed ServerMove RPCs
+	SetNetworkMoveDataContainer(ShooterMoveDataContainer);
+}
 
 void UShooterCharacterMovement::BeginPlay()
 {
@@ -63,16 +89,13 @@ void UShooterCharacterMovement::UpdateFromCompressedFlags(uint8 Flags)
 {
 	Super::UpdateFromCompressedFlags(Flags);
 
-	/*  There are 4 custom move flags for us to use. Below is what each is currently being used for:
-		FLAG_Custom_0		= 0x10, // Sprinting
-		FLAG_Custom_1		= 0x20, // WallRunning
+	/*  There are 4 custom move flags for us to use. None of them are currently used, the sprint and wall run state is sent
+		in FShooterCharacterNetworkMoveData instead:
+		FLAG_Custom_0		= 0x10, // Unused
+		FLAG_Custom_1		= 0x20, // Unused
 		FLAG_Custom_2		= 0x40, // Unused
 		FLAG_Custom_3		= 0x80, // Unused
 	*/
-
-	// Read the values from the compressed flags
-	WantsToSprint = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
-	WallRunKeysDown = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
 }
 
 void UShooterCharacterMovement::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
@@ -102,6 +125,7 @@ void UShooterCharacterMovement::OnMovementModeChanged(EMovementMode PreviousMove
 		{
 			// Unconstrain the character from horizontal movement
 			bConstrainToPlane = false;
+			ClearWallRunSurface();
 		}
 		break;
 		}
@@ -114,7 +138,6 @@ void UShooterCharacterMovement::PhysCustom(float deltaTime, int32 Iterations)
 {
 	// Phys* functions should only run for characters with ROLE_Authority or ROLE_AutonomousProxy. However, Unreal calls PhysCustom in
 	// two seperate locations, one of which doesn't check the role, so we must check it here to prevent this code from running on simulated proxies.
-	UE_LOG(LogTemp, Warning, TEXT("%lf %lf"), Velocity.X, Velocity.Y);
 	if (GetOwner()->GetLocalRole() == ROLE_SimulatedProxy)
 		return;
 
@@ -282,41 +305,55 @@ bool UShooterCharacterMovement::AreRequiredWallRunKeysDown() const
 
 bool UShooterCharacterMovement::IsNextToWall(float vertical_tolerance)
 {
-	// Do a line trace from the player into the wall to make sure we're stil along the side of a wall
+	SCOPE_CYCLE_COUNTER(STAT_ShooterWallRunSurfaceCheck);
+
+	// While the character stays close to where the wall was last traced the wall can't have gone anywhere, only check it
+	// is still on the side we expect (the player may have turned around)
+	if (IsNextToCachedWall(vertical_tolerance))
+	{
+		EWallRunSide newWallRunSide;
+		FindWallRunDirectionAndSide(WallRunSurfaceNormal, WallRunDirection, newWallRunSide);
+		return newWallRunSide == WallRunSide;
+	}
+
+	ClearWallRunSurface();
+
+	// Trace from the player into the wall to make sure we're stil along the side of a wall
 	FVector crossVector = WallRunSide == EWallRunSide::left ? FVector(0.0f, 0.0f, -1.0f) : FVector(0.0f, 0.0f, 1.0f);
 	FVector traceStart = GetCharacterOwner()->GetActorLocation() + (WallRunDirection * 20.0f);
-	FVector traceEnd = traceStart + (FVector::CrossProduct(WallRunDirection, crossVector) * 100);
+	FVector traceEnd = traceStart + (FVector::CrossProduct(WallRunDirection, crossVector) * WallRunTraceLength);
 	FHitResult hitResult;
 
-	// Create a helper lambda for performing the line trace
-	auto lineTrace = [&](const FVector& start, const FVector& end)
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WallRunTrace), false, GetPawnOwner());
+
+	// Helper lambda for performing the line traces
+	auto lineTrace = [&](const FVector& start, const FVector& end, FHitResult& hit)
 	{
-		DrawDebugLine(GetWorld(), start, end, FColor::Green, false, 2, 0, 1);
-		FCollisionQueryParams TraceParams;
-		TraceParams.AddIgnoredActor(GetPawnOwner());
-		return (GetWorld()->LineTraceSingleByChannel(hitResult, start, end, ECollisionChannel::ECC_Visibility, TraceParams));
+		INC_DWORD_STAT(STAT_ShooterWallRunSurfaceTraces);
+		const bool bHit = GetWorld()->LineTraceSingleByChannel(hit, start, end, ECollisionChannel::ECC_Visibility, TraceParams);
+#if ENABLE_DRAW_DEBUG && !UE_SERVER
+		if (DrawWallRunTraces)
+		{
+			DrawDebugLine(GetWorld(), start, end, bHit ? FColor::Green : FColor::Red, false, 2, 0, 1);
+		}
+#endif
+		return bHit;
 	};
 
+	// The calculated line must always hit the wall, it's the hit we use
+	if (lineTrace(traceStart, traceEnd, hitResult) == false)
+		return false;
 
-	// If a vertical tolerance was provided we want to do two line traces - one above and one below the calculated line
+	// If a vertical tolerance was provided the wall must also be there above or below the calculated line
 	if (vertical_tolerance > FLT_EPSILON)
 	{
-		// If both line traces miss the wall then return false, we're not next to a wall
-		if (lineTrace(FVector(traceStart.X, traceStart.Y, traceStart.Z + vertical_tolerance / 2.0f), FVector(traceEnd.X, traceEnd.Y, traceEnd.Z + vertical_tolerance / 2.0f)) == false &&
-			lineTrace(FVector(traceStart.X, traceStart.Y, traceStart.Z - vertical_tolerance / 2.0f), FVector(traceEnd.X, traceEnd.Y, traceEnd.Z - vertical_tolerance / 2.0f)) == false)
+		const FVector offset(0.0f, 0.0f, vertical_tolerance / 2.0f);
+		FHitResult toleranceHit;
+		if (lineTrace(traceStart + offset, traceEnd + offset, toleranceHit) == false &&
+			lineTrace(traceStart - offset, traceEnd - offset, toleranceHit) == false)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Sium"));
 			return false;
 		}
-		if (lineTrace(traceStart, traceEnd) == false)
-			return false;
-	}
-	// If no vertical tolerance was provided we just want to do one line trace using the caclulated line
-	else
-	{
-		// return false if the line trace misses the wall
-		if (lineTrace(traceStart, traceEnd) == false)
-			return false;
 	}
 
 	// Make sure we're still on the side of the wall we expect to be on
@@ -327,9 +364,82 @@ bool UShooterCharacterMovement::IsNextToWall(float vertical_tolerance)
 		return false;
 	}
 
+	// Remember the wall so the next sub-steps can skip the trace
+	UPrimitiveComponent* surface = hitResult.GetComponent();
+	if (surface != nullptr)
+	{
+		WallRunSurface = surface;
+		WallRunSurfaceTransform = surface->GetComponentTransform();
+		WallRunSurfacePoint = hitResult.ImpactPoint;
+		WallRunSurfaceNormal = hitResult.ImpactNormal;
+		WallRunSurfaceRecheckIndex = GetWallRunRecheckIndex(GetCharacterOwner()->GetActorLocation());
+	}
+
+	return true;
+}
+
+bool UShooterCharacterMovement::IsNextToCachedWall(float vertical_tolerance) const
+{
+	const UPrimitiveComponent* surface = WallRunSurface.Get();
+	if (surface == nullptr || IsCustomMovementMode(ECustomMovementMode::CMOVE_WallRunning) == false)
+		return false;
+
+	// The cached wall isn't part of the saved moves, so the client and the server must drop it at the same places. Trace again at
+	// fixed stretches of the wall rather than a distance from wherever each of them happened to fill its cache.
+	// Corrections this leaves show up in the WallRunning column of the movement telemetry (ShooterMovementTelemetry.Stats)
+	const FVector location = GetCharacterOwner()->GetActorLocation();
+	if (GetWallRunRecheckIndex(location) != WallRunSurfaceRecheckIndex)
+		return false;
+
+	// The wall may be on a moving actor
+	if (surface->GetComponentTransform().Equals(WallRunSurfaceTransform) == false)
+		return false;
+
+	// The character must still be in reach of the wall's plane
+	const float distanceToWall = FVector::PointPlaneDist(location, WallRunSurfacePoint, WallRunSurfaceNormal);
+	if (distanceToWall < 0.0f || distanceToWall > WallRunTraceLength)
+		return false;
+
+	// The lines IsNextToWall would trace must still end on the wall, not past its end, top or bottom, or into a doorway.
+	// That can only be told without tracing when the wall's collision is a single box, any other shape is traced every time.
+	const UBodySetup* bodySetup = surface->GetBodySetup();
+	if (bodySetup == nullptr || bodySetup->CollisionTraceFlag == CTF_UseComplexAsSimple || bodySetup->AggGeom.GetElementCount() != 1 || bodySetup->AggGeom.BoxElems.Num() != 1)
+		return false;
+
+	const FKBoxElem& box = bodySetup->AggGeom.BoxElems[0];
+	const FTransform boxTransform = box.GetTransform() * surface->GetComponentTransform();
+	const FVector boxExtent(box.X * 0.5f, box.Y * 0.5f, box.Z * 0.5f);
+	auto isOnBox = [&](const FVector& point)
+	{
+		// The point is on the face of the box, allow for a little imprecision across it
+		const FVector localPoint = boxTransform.InverseTransformPosition(point);
+		return FMath::Abs(localPoint.X) <= boxExtent.X + 1.0f && FMath::Abs(localPoint.Y) <= boxExtent.Y + 1.0f && FMath::Abs(localPoint.Z) <= boxExtent.Z + 1.0f;
+	};
+
+	const FVector traceStart = location + (WallRunDirection * 20.0f);
+	const FVector wallPoint = FVector::PointPlaneProject(traceStart, WallRunSurfacePoint, WallRunSurfaceNormal);
+	if (isOnBox(wallPoint) == false)
+		return false;
+
+	if (vertical_tolerance > FLT_EPSILON)
+	{
+		const FVector offset(0.0f, 0.0f, vertical_tolerance / 2.0f);
+		return isOnBox(wallPoint + offset) || isOnBox(wallPoint - offset);
+	}
+
 	return true;
 }
 
+int32 UShooterCharacterMovement::GetWallRunRecheckIndex(const FVector& location) const
+{
+	return FMath::FloorToInt(FVector::DotProduct(location, WallRunDirection) / FMath::Max(WallRunSurfaceRecheckDistance, 1.0f));
+}
+
+void UShooterCharacterMovement::ClearWallRunSurface()
+{
+	WallRunSurface = nullptr;
+}
+
 void UShooterCharacterMovement::FindWallRunDirectionAndSide(const FVector& surface_normal, FVector& direction, EWallRunSide& side) const
 {
 	FVector crossVector;
@@ -389,7 +499,8 @@ void UShooterCharacterMovement::OnHit(UPrimitiveComponent* HitComponent, AActor*
 	// Update the wall run direction and side
 	FindWallRunDirectionAndSide(Hit.ImpactNormal, WallRunDirection, WallRunSide);
 
-	// Make sure we're next to a wall
+	// Make sure we're next to a wall, tracing the wall we just hit rather than any wall we ran along before
+	ClearWallRunSurface();
 	if (IsNextToWall() == false)
 		return;
 
@@ -413,6 +524,120 @@ FNetworkPredictionData_Client* UShooterCharacterMovement::GetPredictionData_Clie
 	return ClientPredictionData;
 }
 
+void UShooterCharacterMovement::ServerMove_HandleMoveData(const FCharacterNetworkMoveDataContainer& MoveDataContainer)
+{
+	NumServerMovesReceived++;
+	INC_DWORD_STAT(STAT_ShooterServerMoveRPCs);
+
+	if (UShooterMovementTelemetry* Telemetry = UShooterMovementTelemetry::Get(this))
+	{
+		Telemetry->NotifyServerMove(CharacterOwner->GetNetConnection());
+	}
+
+	Super::ServerMove_HandleMoveData(MoveDataContainer);
+}
+
+void UShooterCharacterMovement::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	// Set for new, pending and old moves alike, and only once the time stamp of the move has been accepted
+	const FCharacterNetworkMoveData* MoveData = GetCurrentNetworkMoveData();
+	if (MoveData == nullptr)
+	{
+		Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+		return;
+	}
+
+	// Our container is the only one in use, all moves are ours
+	const FShooterCharacterNetworkMoveData& ShooterMoveData = *static_cast<const FShooterCharacterNetworkMoveData*>(MoveData);
+
+	WantsToSprint = (ShooterMoveData.MoveFlags & FShooterCharacterNetworkMoveData::MOVEFLAG_Sprint) != 0;
+	WallRunKeysDown = (ShooterMoveData.MoveFlags & FShooterCharacterNetworkMoveData::MOVEFLAG_WallRunKeys) != 0;
+
+	// Start the wall trace from the side and direction the client was running in. The server still checks the wall is
+	// there, this only avoids ending the run because the server picked the other side of a corner.
+	if ((ShooterMoveData.MoveFlags & FShooterCharacterNetworkMoveData::MOVEFLAG_WallRunning) != 0 && IsCustomMovementMode(ECustomMovementMode::CMOVE_WallRunning))
+	{
+		const EWallRunSide clientWallRunSide = (ShooterMoveData.MoveFlags & FShooterCharacterNetworkMoveData::MOVEFLAG_WallRunRight) != 0 ? EWallRunSide::right : EWallRunSide::left;
+		if (clientWallRunSide != WallRunSide)
+		{
+			WallRunSide = clientWallRunSide;
+			WallRunDirection = FRotator(0.0f, FRotator::DecompressAxisFromByte(ShooterMoveData.WallRunDirectionYaw), 0.0f).Vector();
+			ClearWallRunSurface();
+		}
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+bool UShooterCharacterMovement::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	// Measured for every move, so forced corrections (bForceClientUpdate) report their own move and not the last one that failed the check
+	LastClientError = FVector::Dist(UpdatedComponent->GetComponentLocation(), ClientWorldLocation);
+
+	return Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+}
+
+void UShooterCharacterMovement::SendClientAdjustment()
+{
+	const FNetworkPredictionData_Server_Character* ServerData = HasPredictionData_Server() ? GetPredictionData_Server_Character() : nullptr;
+	const float LastAdjustmentTime = ServerData ? ServerData->ServerLastClientAdjustmentTime : 0.0f;
+
+	Super::SendClientAdjustment();
+
+	// Pending corrections are throttled by NetworkMinTimeBetweenClientAdjustments, only count the ones that were sent
+	if (ServerData && ServerData->ServerLastClientAdjustmentTime != LastAdjustmentTime)
+	{
+		NumClientCorrections++;
+		INC_DWORD_STAT(STAT_ShooterClientCorrections);
+
+		if (UShooterMovementTelemetry* Telemetry = UShooterMovementTelemetry::Get(this))
+		{
+			Telemetry->NotifyCorrection(CharacterOwner->GetNetConnection(), LastClientError, MovementMode, CustomMovementMode);
+		}
+	}
+}
+
+FShooterCharacterNetworkMoveDataContainer::FShooterCharacterNetworkMoveDataContainer()
+{
+	NewMoveData = &ShooterMoveData[0];
+	PendingMoveData = &ShooterMoveData[1];
+	OldMoveData = &ShooterMoveData[2];
+}
+
+void FShooterCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_ShooterCharacter& ShooterMove = static_cast<const FSavedMove_ShooterCharacter&>(ClientMove);
+
+	MoveFlags = 0;
+	if (ShooterMove.SavedWantsToSprint)
+		MoveFlags |= MOVEFLAG_Sprint;
+	if (ShooterMove.SavedWallRunKeysDown)
+		MoveFlags |= MOVEFLAG_WallRunKeys;
+	if (ShooterMove.SavedWallRunning)
+	{
+		MoveFlags |= MOVEFLAG_WallRunning;
+		if (ShooterMove.SavedWallRunSide == EWallRunSide::right)
+			MoveFlags |= MOVEFLAG_WallRunRight;
+	}
+
+	WallRunDirectionYaw = FRotator::CompressAxisToByte(ShooterMove.SavedWallRunDirection.Rotation().Yaw);
+}
+
+bool FShooterCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	Ar.SerializeBits(&MoveFlags, NumMoveFlagBits);
+	if ((MoveFlags & MOVEFLAG_WallRunning) != 0)
+	{
+		Ar << WallRunDirectionYaw;
+	}
+
+	return !Ar.IsError();
+}
+
 FNetworkPredictionData_Client_ShooterCharacter::FNetworkPredictionData_Client_ShooterCharacter(const UCharacterMovementComponent& ClientMovement)
 	: Super(ClientMovement) 
 {
@@ -431,24 +656,16 @@ void FSavedMove_ShooterCharacter::Clear()
 	// Clear all values
 	SavedWantsToSprint = 0;
 	SavedWallRunKeysDown = 0;
+	SavedWallRunning = 0;
+	SavedWallRunSide = EWallRunSide::left;
+	SavedWallRunDirection = FVector::ZeroVector;
 }
 
 uint8 FSavedMove_ShooterCharacter::GetCompressedFlags() const
 {
 	uint8 Result = Super::GetCompressedFlags();
 
-	/* There are 4 custom move flags for us to use. Below is what each is currently being used for:
-	FLAG_Custom_0		= 0x10, // Sprinting
-	FLAG_Custom_1		= 0x20, // WallRunning
-	FLAG_Custom_2		= 0x40, // Unused
-	FLAG_Custom_3		= 0x80, // Unused
-	*/
-
-	// Write to the compressed flags 
-	if (SavedWantsToSprint)
-		Result |= FLAG_Custom_0;
-	if (SavedWallRunKeysDown)
-		Result |= FLAG_Custom_1;
+	// The sprint and wall run state is written by FShooterCharacterNetworkMoveData, the custom flags are unused
 
 	return Result;
 }
@@ -459,7 +676,14 @@ bool FSavedMove_ShooterCharacter::CanCombineWith(const FSavedMovePtr& NewMovePtr
 
 	// As an optimization, check if the engine can combine saved moves.
 	if (SavedWantsToSprint != NewMove->SavedWantsToSprint ||
-		SavedWallRunKeysDown != NewMove->SavedWallRunKeysDown)
+		SavedWallRunKeysDown != NewMove->SavedWallRunKeysDown ||
+		SavedWallRunning != NewMove->SavedWallRunning)
+	{
+		return false;
+	}
+
+	// Wall run moves along the same side of the wall can be combined
+	if (SavedWallRunning && SavedWallRunSide != NewMove->SavedWallRunSide)
 	{
 		return false;
 	}
@@ -477,9 +701,32 @@ void FSavedMove_ShooterCharacter::SetMoveFor(ACharacter* Character, float InDelt
 		// Copy values into the saved move
 		SavedWantsToSprint = CharMove->WantsToSprint;
 		SavedWallRunKeysDown = CharMove->WallRunKeysDown;
+		SavedWallRunning = CharMove->IsCustomMovementMode(ECustomMovementMode::CMOVE_WallRunning);
+		SavedWallRunSide = CharMove->WallRunSide;
+		SavedWallRunDirection = CharMove->WallRunDirection;
+
+		// PhysWallRunning ignores the input acceleration, so line it up with the wall. Otherwise looking around while
+		// running along a wall changes its direction every frame and none of the moves can be combined.
+		if (SavedWallRunning && AccelMag > SMALL_NUMBER && !SavedWallRunDirection.IsNearlyZero())
+		{
+			AccelNormal = SavedWallRunDirection.GetSafeNormal2D();
+			Acceleration = AccelNormal * AccelMag;
+		}
 	}
 }
 
+bool FSavedMove_ShooterCharacter::IsImportantMove(const FSavedMovePtr& LastAckedMovePtr) const
+{
+	// The sprint and wall run keys are not in the compressed flags, so the engine can't see them change
+	const FSavedMove_ShooterCharacter* LastAckedMove = static_cast<const FSavedMove_ShooterCharacter*>(LastAckedMovePtr.Get());
+	if (SavedWantsToSprint != LastAckedMove->SavedWantsToSprint || SavedWallRunKeysDown != LastAckedMove->SavedWallRunKeysDown)
+	{
+		return true;
+	}
+
+	return Super::IsImportantMove(LastAckedMovePtr);
+}
+
 void FSavedMove_ShooterCharacter::PrepMoveFor(class ACharacter* Character)
 {
 	Super::PrepMoveFor(Character);
@@ -490,6 +737,11 @@ void FSavedMove_ShooterCharacter::PrepMoveFor(class ACharacter* Character)
 		// Copt values out of the saved move
 		CharMove->WantsToSprint = SavedWantsToSprint;
 		CharMove->WallRunKeysDown = SavedWallRunKeysDown;
+		if (SavedWallRunning)
+		{
+			CharMove->WallRunSide = SavedWallRunSide;
+			CharMove->WallRunDirection = SavedWallRunDirection;
+		}
 	}
 }
 
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterCharacterSignificance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Significance Update"), STAT_ShooterCharacterSignificance, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Low Significance Characters"), STAT_ShooterLowSignificanceCharacters, STATGROUP_Shooter);
+
+static float SignificanceUpdateInterval = 0.1f;
+FAutoConsoleVariableRef CVarSignificanceUpdateInterval(
+	TEXT("p.SignificanceUpdateInterval"),
+	SignificanceUpdateInterval,
+	TEXT("How often (in seconds) the significance of the characters is updated"),
+	ECVF_Default);
+
+static float SignificanceNearDistance = 2000.f;
+FAutoConsoleVariableRef CVarSignificanceNearDistance(
+	TEXT("p.SignificanceNearDistance"),
+	SignificanceNearDistance,
+	TEXT("Characters closer than this to a local viewer are highly significant, seen or not, so they can be heard"),
+	ECVF_Default);
+
+static int32 SignificanceMaxHigh = 8;
+FAutoConsoleVariableRef CVarSignificanceMaxHigh(
+	TEXT("p.SignificanceMaxHigh"),
+	SignificanceMaxHigh,
+	TEXT("Most characters of high significance besides the viewed ones, the nearest are kept and the others demoted to medium"),
+	ECVF_Default);
+
+/** how recently a character must have been rendered to count as seen */
+static const float SignificanceRenderedTolerance = 0.2f;
+
+bool UShooterCharacterSignificance::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UShooterCharacterSignificance::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return !IsTemplate() && World && World->IsGameWorld();
+}
+
+TStatId UShooterCharacterSignificance::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterCharacterSignificance, STATGROUP_Tickables);
+}
+
+void UShooterCharacterSignificance::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (Now - LastUpdateTime >= SignificanceUpdateInterval)
+	{
+		LastUpdateTime = Now;
+		UpdateSignificance();
+	}
+}
+
+void UShooterCharacterSignificance::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterSignificance);
+
+	UWorld* World = GetWorld();
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	TArray<const AActor*, TInlineAllocator<4>> ViewTargets;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+			ViewTargets.Add(PC->GetViewTarget());
+		}
+	}
+
+	// no local viewer yet (e.g. still loading), leave everything as it is
+	if (ViewLocations.Num() == 0)
+	{
+		return;
+	}
+
+	const float NearDistSq = FMath::Square(SignificanceNearDistance);
+
+	Candidates.Reset();
+	for (AShooterCharacter* Character : TActorRange<AShooterCharacter>(World))
+	{
+		// what local players look through is always fully updated
+		if (ViewTargets.Contains(Character) || Character->IsLocallyControlled())
+		{
+			Character->SetSignificance(EShooterSignificance::High);
+			continue;
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		float MinDistSq = MAX_flt;
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			MinDistSq = FMath::Min(MinDistSq, FVector::DistSquared(ViewLocation, Location));
+		}
+
+		// whatever is on screen stays at least Medium however far it is, a player can aim at it
+		const bool bRendered = Character->WasRecentlyRendered(SignificanceRenderedTolerance);
+		if (!bRendered && MinDistSq > NearDistSq)
+		{
+			Character->SetSignificance(EShooterSignificance::Low);
+			INC_DWORD_STAT(STAT_ShooterLowSignificanceCharacters);
+			continue;
+		}
+
+		Candidates.Add({ Character, MinDistSq, bRendered });
+	}
+
+	// the nearest ones are High, within budget, close characters are heard even when they aren't seen
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+	for (int32 i = 0; i < Candidates.Num(); i++)
+	{
+		const FCandidate& Candidate = Candidates[i];
+		const bool bHigh = Candidate.DistSq <= NearDistSq && i < SignificanceMaxHigh;
+		const EShooterSignificance::Type Significance = bHigh ? EShooterSignificance::High : (Candidate.bRendered ? EShooterSignificance::Medium : EShooterSignificance::Low);
+		Candidate.Character->SetSignificance(Significance);
+		if (Significance == EShooterSignificance::Low)
+		{
+			INC_DWORD_STAT(STAT_ShooterLowSignificanceCharacters);
+		}
+	}
+}
+
+void UShooterCharacterSignificance::Deinitialize()
+{
+	Candidates.Empty();
+
+	Super::Deinitialize();
+}
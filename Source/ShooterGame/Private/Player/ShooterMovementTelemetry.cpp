@@ -0,0 +1,231 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterMovementTelemetry.h"
+#include "Engine/NetConnection.h"
+
+static float MovementTelemetryInterval = 10.f;
+FAutoConsoleVariableRef CVarMovementTelemetryInterval(
+	TEXT("p.MovementTelemetryInterval"),
+	MovementTelemetryInterval,
+	TEXT("Length (in seconds) of the intervals movement telemetry rates are computed over, a csv row is written per connection and interval on dedicated servers.\n")
+	TEXT("0: Disable the csv and rates"),
+	ECVF_Default);
+
+FAutoConsoleCommandWithWorld ShooterMovementTelemetryStatsCmd(TEXT("ShooterMovementTelemetry.Stats"), TEXT("Prints ServerMove rate, corrections and round trip time per client connection"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* InWorld)
+	{
+		if (UShooterMovementTelemetry* Telemetry = UShooterMovementTelemetry::Get(InWorld))
+		{
+			Telemetry->DumpStats();
+		}
+	})
+);
+
+UShooterMovementTelemetry* UShooterMovementTelemetry::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UShooterMovementTelemetry>() : nullptr;
+}
+
+void UShooterMovementTelemetry::NotifyServerMove(UNetConnection* Connection)
+{
+	if (FConnectionStats* Stats = FindOrAddStats(Connection))
+	{
+		Stats->Current.ServerMoves++;
+	}
+}
+
+void UShooterMovementTelemetry::NotifyCorrection(UNetConnection* Connection, float Error, uint8 MovementMode, uint8 CustomMovementMode)
+{
+	if (FConnectionStats* Stats = FindOrAddStats(Connection))
+	{
+		Stats->Current.Corrections++;
+		Stats->Current.CorrectionsByMode[GetModeBucket(MovementMode, CustomMovementMode)]++;
+		Stats->Current.ErrorSum += Error;
+		Stats->Current.MaxError = FMath::Max(Stats->Current.MaxError, Error);
+	}
+}
+
+UShooterMovementTelemetry::FConnectionStats* UShooterMovementTelemetry::FindOrAddStats(UNetConnection* Connection)
+{
+	if (Connection == nullptr)
+	{
+		return nullptr;
+	}
+
+	FConnectionStats& Stats = Connections.FindOrAdd(Connection);
+	if (Stats.Connection.Get() != Connection)
+	{
+		Stats = FConnectionStats();
+		Stats.Connection = Connection;
+
+		const APlayerState* PlayerState = Connection->PlayerController ? Connection->PlayerController->PlayerState : nullptr;
+		Stats.Name = PlayerState ? PlayerState->GetPlayerName() : Connection->LowLevelGetRemoteAddress();
+	}
+	return &Stats;
+}
+
+void UShooterMovementTelemetry::FIntervalStats::Add(const FIntervalStats& Other)
+{
+	ServerMoves += Other.ServerMoves;
+	Corrections += Other.Corrections;
+	for (int32 i = 0; i < NumModeBuckets; i++)
+	{
+		CorrectionsByMode[i] += Other.CorrectionsByMode[i];
+	}
+	ErrorSum += Other.ErrorSum;
+	MaxError = FMath::Max(MaxError, Other.MaxError);
+}
+
+bool UShooterMovementTelemetry::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return !IsTemplate() && World && World->GetNetMode() != NM_Client && World->GetNetMode() != NM_Standalone && MovementTelemetryInterval > 0.f;
+}
+
+TStatId UShooterMovementTelemetry::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterMovementTelemetry, STATGROUP_Tickables);
+}
+
+void UShooterMovementTelemetry::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (IntervalStartTime == 0.0)
+	{
+		IntervalStartTime = Now;
+	}
+	else if (Now - IntervalStartTime >= MovementTelemetryInterval)
+	{
+		EndInterval(Now - IntervalStartTime);
+		IntervalStartTime = Now;
+	}
+}
+
+void UShooterMovementTelemetry::EndInterval(float IntervalLength)
+{
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		FConnectionStats& Stats = It.Value();
+		UNetConnection* Connection = Stats.Connection.Get();
+		if (Connection == nullptr || Connection->State == USOCK_Closed)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		Stats.ServerMoveRate = Stats.Current.ServerMoves / IntervalLength;
+		Stats.CorrectionRate = Stats.Current.Corrections / IntervalLength;
+		Stats.RoundTripTime = Connection->AvgLag * 1000.f;
+	}
+
+	if (GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		WriteCsvRows();
+	}
+
+	for (auto& It : Connections)
+	{
+		It.Value.Total.Add(It.Value.Current);
+		It.Value.Current = FIntervalStats();
+	}
+}
+
+void UShooterMovementTelemetry::WriteCsvRows()
+{
+	if (Connections.Num() == 0 || bCsvFailed)
+	{
+		return;
+	}
+
+	if (!CsvWriter)
+	{
+		const FString Path = FPaths::ProjectLogDir() / FString::Printf(TEXT("MovementTelemetry-%s.csv"), *FDateTime::Now().ToString());
+		CsvWriter.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_AllowRead));
+		if (!CsvWriter)
+		{
+			UE_LOG(LogShooter, Warning, TEXT("Couldn't open %s, movement telemetry won't be written"), *Path);
+			bCsvFailed = true;
+			return;
+		}
+
+		FString Header = TEXT("Time,Player,ServerMovesPerSec,CorrectionsPerSec,Corrections,AvgError,MaxError,RoundTripMs");
+		for (int32 i = 0; i < NumModeBuckets; i++)
+		{
+			Header += FString::Printf(TEXT(",%sCorrections"), GetModeBucketName(i));
+		}
+		Header += TEXT("\n");
+		FTCHARToUTF8 Utf8Header(*Header);
+		CsvWriter->Serialize((void*)Utf8Header.Get(), Utf8Header.Length());
+	}
+
+	const float Time = GetWorld()->GetTimeSeconds();
+	for (const auto& It : Connections)
+	{
+		const FConnectionStats& Stats = It.Value;
+		FString Row = FString::Printf(TEXT("%.1f,\"%s\",%.1f,%.2f,%u,%.1f,%.1f,%.0f"), Time, *Stats.Name.Replace(TEXT("\""), TEXT("\"\"")),
+			Stats.ServerMoveRate, Stats.CorrectionRate, Stats.Current.Corrections,
+			Stats.Current.Corrections > 0 ? Stats.Current.ErrorSum / Stats.Current.Corrections : 0.f, Stats.Current.MaxError, Stats.RoundTripTime);
+		for (int32 i = 0; i < NumModeBuckets; i++)
+		{
+			Row += FString::Printf(TEXT(",%u"), Stats.Current.CorrectionsByMode[i]);
+		}
+		Row += TEXT("\n");
+
+		FTCHARToUTF8 Utf8Row(*Row);
+		CsvWriter->Serialize((void*)Utf8Row.Get(), Utf8Row.Length());
+	}
+	CsvWriter->Flush();
+}
+
+void UShooterMovementTelemetry::DumpStats() const
+{
+	for (const auto& It : Connections)
+	{
+		const FConnectionStats& Stats = It.Value;
+		FIntervalStats Total = Stats.Total;
+		Total.Add(Stats.Current);
+
+		FString ModeDesc;
+		for (int32 i = 0; i < NumModeBuckets; i++)
+		{
+			if (Total.CorrectionsByMode[i] > 0)
+			{
+				ModeDesc += FString::Printf(TEXT(" %s:%u"), GetModeBucketName(i), Total.CorrectionsByMode[i]);
+			}
+		}
+
+		UE_LOG(LogShooter, Display, TEXT("%s: %.1f moves/s, %.2f corrections/s, %u moves, %u corrections (avg error %.1f, max %.1f), rtt %.0f ms, by mode:%s"),
+			*Stats.Name, Stats.ServerMoveRate, Stats.CorrectionRate, Total.ServerMoves, Total.Corrections,
+			Total.Corrections > 0 ? Total.ErrorSum / Total.Corrections : 0.f, Total.MaxError, Stats.RoundTripTime, *ModeDesc);
+	}
+}
+
+int32 UShooterMovementTelemetry::GetModeBucket(uint8 MovementMode, uint8 CustomMovementMode)
+{
+	if (MovementMode != MOVE_Custom)
+	{
+		return FMath::Min<int32>(MovementMode, MOVE_Custom - 1);
+	}
+	return MOVE_Custom + FMath::Min<int32>(CustomMovementMode, CMOVE_MAX - 1);
+}
+
+const TCHAR* UShooterMovementTelemetry::GetModeBucketName(int32 Bucket)
+{
+	static const TCHAR* BucketNames[] = { TEXT("None"), TEXT("Walking"), TEXT("NavWalking"), TEXT("Falling"), TEXT("Swimming"), TEXT("Flying"), TEXT("WallRunning") };
+	static_assert(UE_ARRAY_COUNT(BucketNames) == NumModeBuckets, "Add a name for the new movement mode");
+	return BucketNames[Bucket];
+}
+
+void UShooterMovementTelemetry::Deinitialize()
+{
+	if (CsvWriter)
+	{
+		CsvWriter->Close();
+		CsvWriter.Reset();
+	}
+	Connections.Empty();
+
+	Super::Deinitialize();
+}
@@ -20,7 +20,6 @@
 #include "ShooterLeaderboards.h"
 #include "ShooterGameViewportClient.h"
 #include "Sound/SoundNodeLocalPlayer.h"
-#include "AudioThread.h"
 #include "OnlineSubsystemUtils.h"
 
 #define  ACH_FRAG_SOMEONE	TEXT("ACH_FRAG_SOMEONE")
@@ -159,12 +158,7 @@ void AShooterPlayerController::TickActor(float DeltaTime, enum ELevelTick TickTy
 		}
 	}
 
-	const bool bLocallyControlled = IsLocalController();
-	const uint32 UniqueID = GetUniqueID();
-	FAudioThread::RunCommandOnAudioThread([UniqueID, bLocallyControlled]()
-	{
-		USoundNodeLocalPlayer::GetLocallyControlledActorCache().Add(UniqueID, bLocallyControlled);
-	});
+	USoundNodeLocalPlayer::SetLocallyControlled(GetUniqueID(), IsLocalController());
 };
 
 void AShooterPlayerController::BeginDestroy()
@@ -177,11 +171,7 @@ void AShooterPlayerController::BeginDestroy()
 
 	if (!GExitPurge)
 	{
-		const uint32 UniqueID = GetUniqueID();
-		FAudioThread::RunCommandOnAudioThread([UniqueID]()
-		{
-			USoundNodeLocalPlayer::GetLocallyControlledActorCache().Remove(UniqueID);
-		});
+		USoundNodeLocalPlayer::RemoveActor(GetUniqueID());
 	}
 }
 
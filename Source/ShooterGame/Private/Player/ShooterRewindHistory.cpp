@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterRewindHistory.h"
+
+FShooterRewindHistory::FShooterRewindHistory()
+	: Head(0)
+	, NumSamples(0)
+{
+}
+
+void FShooterRewindHistory::Record(float Time, const FVector& CapsuleLocation, const FBoxSphereBounds& HitboxBounds)
+{
+	// several ticks in the same world time (e.g. paused world), just refresh the latest sample
+	if (NumSamples > 0 && Time <= Times[GetSlot(NumSamples - 1)])
+	{
+		const int32 Latest = GetSlot(NumSamples - 1);
+		CapsuleLocations[Latest] = CapsuleLocation;
+		HitboxOrigins[Latest] = HitboxBounds.Origin;
+		HitboxExtents[Latest] = HitboxBounds.BoxExtent;
+		return;
+	}
+
+	Times[Head] = Time;
+	CapsuleLocations[Head] = CapsuleLocation;
+	HitboxOrigins[Head] = HitboxBounds.Origin;
+	HitboxExtents[Head] = HitboxBounds.BoxExtent;
+
+	Head = (Head + 1) % MaxSamples;
+	NumSamples = FMath::Min(NumSamples + 1, MaxSamples);
+}
+
+bool FShooterRewindHistory::GetPoseAtTime(float Time, FVector& OutCapsuleLocation, FBox& OutHitbox) const
+{
+	if (NumSamples == 0 || Time < Times[GetSlot(0)])
+	{
+		return false;
+	}
+
+	const int32 LatestSlot = GetSlot(NumSamples - 1);
+	if (Time >= Times[LatestSlot])
+	{
+		OutCapsuleLocation = CapsuleLocations[LatestSlot];
+		OutHitbox = FBox(HitboxOrigins[LatestSlot] - HitboxExtents[LatestSlot], HitboxOrigins[LatestSlot] + HitboxExtents[LatestSlot]);
+		return true;
+	}
+
+	// binary search for the first sample newer than Time, the oldest sample is known to be <= Time
+	int32 Low = 1;
+	int32 High = NumSamples - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Times[GetSlot(Mid)] > Time)
+		{
+			High = Mid;
+		}
+		else
+		{
+			Low = Mid + 1;
+		}
+	}
+
+	const int32 Before = GetSlot(Low - 1);
+	const int32 After = GetSlot(Low);
+	const float Span = Times[After] - Times[Before];
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? (Time - Times[Before]) / Span : 1.f;
+
+	OutCapsuleLocation = FMath::Lerp(CapsuleLocations[Before], CapsuleLocations[After], Alpha);
+
+	const FVector Origin = FMath::Lerp(HitboxOrigins[Before], HitboxOrigins[After], Alpha);
+	const FVector Extent = FMath::Lerp(HitboxExtents[Before], HitboxExtents[After], Alpha);
+	OutHitbox = FBox(Origin - Extent, Origin + Extent);
+
+	return true;
+}
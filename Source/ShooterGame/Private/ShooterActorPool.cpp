@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterActorPool.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Actor Pool Hits"), STAT_ShooterActorPoolHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Actor Pool Misses"), STAT_ShooterActorPoolMisses, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Actor Pool Inactive"), STAT_ShooterActorPoolInactive, STATGROUP_Shooter);
+
+static int32 ActorPoolMaxInactive = 64;
+FAutoConsoleVariableRef CVarActorPoolMaxInactive(
+	TEXT("p.ActorPoolMaxInactive"),
+	ActorPoolMaxInactive,
+	TEXT("Most inactive actors kept per class, further released actors are destroyed.\n")
+	TEXT("0: Disable pooling"),
+	ECVF_Default);
+
+FAutoConsoleCommandWithWorld ShooterActorPoolStatsCmd(TEXT("ShooterActorPool.Stats"), TEXT("Prints hits, misses and size of the actor pool per class"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* InWorld)
+	{
+		if (UShooterActorPool* Pool = UShooterActorPool::Get(InWorld))
+		{
+			Pool->DumpStats();
+		}
+	})
+);
+
+UShooterPooledActor::UShooterPooledActor(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+}
+
+UShooterActorPool* UShooterActorPool::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UShooterActorPool>() : nullptr;
+}
+
+void UShooterActorPool::ReleaseOrDestroy(AActor* Actor)
+{
+	UShooterActorPool* Pool = Get(Actor);
+	if (Pool)
+	{
+		Pool->Release(Actor);
+	}
+	else
+	{
+		Actor->Destroy();
+	}
+}
+
+AActor* UShooterActorPool::BeginAcquire(TSubclassOf<AActor> ActorClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	if (ActorClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	FShooterPooledActorList& Pool = Pools.FindOrAdd(ActorClass);
+	while (Pool.Actors.Num() > 0)
+	{
+		AActor* Actor = Pool.Actors.Pop(false);
+		DEC_DWORD_STAT(STAT_ShooterActorPoolInactive);
+
+		// destroyed while pooled, e.g. by a level unload
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		Pool.NumHits++;
+		INC_DWORD_STAT(STAT_ShooterActorPoolHits);
+
+		Actor->SetOwner(Owner);
+		Actor->SetInstigator(Instigator);
+		Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+		return Actor;
+	}
+
+	Pool.NumMisses++;
+	INC_DWORD_STAT(STAT_ShooterActorPoolMisses);
+
+	return GetWorld()->SpawnActorDeferred<AActor>(ActorClass, Transform, Owner, Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+}
+
+void UShooterActorPool::FinishAcquire(AActor* Actor, const FTransform& Transform)
+{
+	if (!Actor->IsActorInitialized())
+	{
+		Actor->FinishSpawning(Transform);
+	}
+	else
+	{
+		Actor->SetActorHiddenInGame(false);
+		Actor->SetActorEnableCollision(true);
+		Actor->SetActorTickEnabled(true);
+
+		if (Actor->GetIsReplicated() && Actor->GetLocalRole() == ROLE_Authority)
+		{
+			Actor->SetNetDormancy(DORM_Awake);
+			Actor->ForceNetUpdate();
+		}
+	}
+
+	if (IShooterPooledActor* PooledActor = Cast<IShooterPooledActor>(Actor))
+	{
+		PooledActor->OnAcquiredFromPool();
+	}
+}
+
+void UShooterActorPool::Release(AActor* Actor)
+{
+	if (!IsValid(Actor) || Actor->IsActorBeingDestroyed())
+	{
+		return;
+	}
+
+	FShooterPooledActorList& Pool = Pools.FindOrAdd(Actor->GetClass());
+	if (Pool.Actors.Num() >= ActorPoolMaxInactive)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	Deactivate(Actor);
+
+	Pool.Actors.Add(Actor);
+	INC_DWORD_STAT(STAT_ShooterActorPoolInactive);
+}
+
+void UShooterActorPool::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	if (ActorClass == nullptr)
+	{
+		return;
+	}
+
+	FShooterPooledActorList& Pool = Pools.FindOrAdd(ActorClass);
+	const int32 NumToSpawn = FMath::Min(Count, ActorPoolMaxInactive) - Pool.Actors.Num();
+	for (int32 i = 0; i < NumToSpawn; i++)
+	{
+		AActor* Actor = GetWorld()->SpawnActorDeferred<AActor>(ActorClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Actor == nullptr)
+		{
+			break;
+		}
+
+		// start out dormant so it isn't replicated again until it's first used,
+		// clients still receive it once when it spawns
+		if (Actor->GetIsReplicated())
+		{
+			Actor->NetDormancy = DORM_DormantAll;
+		}
+
+		Actor->FinishSpawning(FTransform::Identity);
+		Deactivate(Actor);
+
+		Pool.Actors.Add(Actor);
+		INC_DWORD_STAT(STAT_ShooterActorPoolInactive);
+	}
+}
+
+void UShooterActorPool::Deactivate(AActor* Actor)
+{
+	if (IShooterPooledActor* PooledActor = Cast<IShooterPooledActor>(Actor))
+	{
+		PooledActor->OnReleasedToPool();
+	}
+
+	Actor->SetLifeSpan(0.0f);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	// keep the channel, the hidden state still goes out before it goes dormant
+	if (Actor->GetIsReplicated() && Actor->GetLocalRole() == ROLE_Authority)
+	{
+		Actor->SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+void UShooterActorPool::DumpStats() const
+{
+	for (const auto& It : Pools)
+	{
+		const FShooterPooledActorList& Pool = It.Value;
+		const int32 NumAcquired = Pool.NumHits + Pool.NumMisses;
+		UE_LOG(LogShooter, Display, TEXT("%s: %d inactive, %d hits, %d misses (%.1f%% hit rate)"), *GetNameSafe(It.Key), Pool.Actors.Num(), Pool.NumHits, Pool.NumMisses,
+			NumAcquired > 0 ? 100.0f * Pool.NumHits / NumAcquired : 0.0f);
+	}
+}
+
+void UShooterActorPool::Deinitialize()
+{
+	for (const auto& It : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_ShooterActorPoolInactive, It.Value.Actors.Num());
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
@@ -66,17 +66,14 @@ static void WebServerDelegate(int32 UserIndex, const FString& Action, const FStr
 					AShooterGameState* const GameState = Player->PlayerController->GetWorld()->GetGameState<AShooterGameState>();
 
 
-					RankedPlayerMap Players;
-					GameState->GetRankedMap(0, Players);
-
 					bool bNeedsComma = false;
-					for (auto It = Players.CreateIterator(); It; ++It)
+					for (const TWeakObjectPtr<AShooterPlayerState>& Player : GameState->GetRankedPlayers(0))
 					{
 						if (bNeedsComma)
 						{
 							ScoreboardStr += TEXT(" ,");
 						}
-						ScoreboardStr += FString::Printf(TEXT(" { \"n\" : \"%s\" , \"k\" : \"%d\" , \"d\" : \"%d\" }"), *It.Value()->GetShortPlayerName(), It.Value()->GetKills(), It.Value()->GetDeaths());
+						ScoreboardStr += FString::Printf(TEXT(" { \"n\" : \"%s\" , \"k\" : \"%d\" , \"d\" : \"%d\" }"), *Player->GetShortPlayerName(), Player->GetKills(), Player->GetDeaths());
 						bNeedsComma = true;
 					}
 				}
@@ -18,6 +18,7 @@
 #include "Online/ShooterPlayerState.h"
 #include "Online/ShooterGameSession.h"
 #include "Online/ShooterOnlineSessionClient.h"
+#include "Online/ShooterReplayAnalyzer.h"
 #include "OnlineSubsystemUtils.h"
 
 #if !defined(CONTROLLER_SWAPPING)
@@ -305,6 +306,13 @@ void UShooterGameInstance::OnPostDemoPlay()
 
 void UShooterGameInstance::HandleDemoPlaybackFailure( EDemoPlayFailure::Type FailureType, const FString& ErrorString )
 {
+	if (UShooterReplayAnalyzer::IsAnalyzing())
+	{
+		UE_LOG(LogShooter, Error, TEXT("Failed to analyze replay %s: %s"), *UShooterReplayAnalyzer::GetReplayName(), *ErrorString);
+		FPlatformMisc::RequestExitWithStatus(false, 1);
+		return;
+	}
+
 	if (GetWorld() != nullptr && GetWorld()->WorldType == EWorldType::PIE)
 	{
 		UE_LOG(LogEngine, Warning, TEXT("Demo failed to play back correctly, got error %s"), *ErrorString);
@@ -321,6 +329,14 @@ void UShooterGameInstance::StartGameInstance()
 
 	const TCHAR* Cmd = FCommandLine::Get();
 
+	// headless replay analysis skips the menus, the analyzer exits once the replay is done
+	if (UShooterReplayAnalyzer::IsAnalyzing())
+	{
+		LoadFrontEndMap(MainMenuMap);
+		PlayReplay(UShooterReplayAnalyzer::GetReplayName());
+		return;
+	}
+
 	// Catch the case where we want to override the map name on startup (used for connecting to other MP instances)
 	if (FParse::Token(Cmd, Parm, UE_ARRAY_COUNT(Parm), 0) && Parm[0] != '-')
 	{
@@ -3,10 +3,13 @@
 #include "ShooterGame.h"
 #include "Sound/SoundNodeLocalPlayer.h"
 #include "SoundDefinitions.h"
+#include "AudioThread.h"
 
 #define LOCTEXT_NAMESPACE "SoundNodeLocalPlayer"
 
-TMap<uint32, bool> USoundNodeLocalPlayer::LocallyControlledActorCache;
+USoundNodeLocalPlayer::FLocallyControlledSet USoundNodeLocalPlayer::PendingLocallyControlledActors;
+USoundNodeLocalPlayer::FLocallyControlledSet USoundNodeLocalPlayer::LocallyControlledActors;
+bool USoundNodeLocalPlayer::bPendingDirty = false;
 
 USoundNodeLocalPlayer::USoundNodeLocalPlayer(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -14,11 +17,8 @@ USoundNodeLocalPlayer::USoundNodeLocalPlayer(const FObjectInitializer& ObjectIni
 
 void USoundNodeLocalPlayer::ParseNodes(FAudioDevice* AudioDevice, const UPTRINT NodeWaveInstanceHash, FActiveSound& ActiveSound, const FSoundParseParameters& ParseParams, TArray<FWaveInstance*>& WaveInstances)
 {
-	bool bLocallyControlled = false;
-	if (bool* LocallyControlledPtr = LocallyControlledActorCache.Find(ActiveSound.GetOwnerID()))
-	{
-		bLocallyControlled = *LocallyControlledPtr;
-	}
+	check(IsInAudioThread());
+	const bool bLocallyControlled = LocallyControlledActors.Contains(ActiveSound.GetOwnerID());
 
 	const int32 PlayIndex = bLocallyControlled ? 0 : 1;
 
@@ -28,6 +28,57 @@ void USoundNodeLocalPlayer::ParseNodes(FAudioDevice* AudioDevice, const UPTRINT
 	}
 }
 
+void USoundNodeLocalPlayer::SetLocallyControlled(uint32 UniqueID, bool bLocallyControlled)
+{
+	check(IsInGameThread());
+
+	if (PendingLocallyControlledActors.Contains(UniqueID) == bLocallyControlled)
+	{
+		return;
+	}
+
+	if (bLocallyControlled)
+	{
+		PendingLocallyControlledActors.Add(UniqueID);
+	}
+	else
+	{
+		PendingLocallyControlledActors.RemoveSingleSwap(UniqueID);
+	}
+
+	if (!bPendingDirty)
+	{
+		bPendingDirty = true;
+
+		static bool bRegistered = false;
+		if (!bRegistered)
+		{
+			bRegistered = true;
+			FCoreDelegates::OnEndFrame.AddStatic(&USoundNodeLocalPlayer::PublishLocallyControlledActors);
+		}
+	}
+}
+
+void USoundNodeLocalPlayer::RemoveActor(uint32 UniqueID)
+{
+	SetLocallyControlled(UniqueID, false);
+}
+
+void USoundNodeLocalPlayer::PublishLocallyControlledActors()
+{
+	if (!bPendingDirty)
+	{
+		return;
+	}
+	bPendingDirty = false;
+
+	// one command per frame at most, and only in frames where a local player possessed, unpossessed or went away
+	FAudioThread::RunCommandOnAudioThread([Snapshot = PendingLocallyControlledActors]()
+	{
+		LocallyControlledActors = Snapshot;
+	});
+}
+
 #if WITH_EDITOR
 FText USoundNodeLocalPlayer::GetInputPinName(int32 PinIndex) const
 {
@@ -14,6 +14,12 @@
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
+DECLARE_CYCLE_STAT(TEXT("HUD Draw"), STAT_ShooterHUDDraw, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Text Measurements"), STAT_ShooterHUDTextMeasurements, STATGROUP_Shooter);
+
+/** the cache is flushed when it gets this big, ammo counts and timers keep adding strings */
+static const int32 MaxCachedHUDTexts = 256;
+
 const float AShooterHUD::MinHudScale = 0.5f;
 
 AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -176,27 +182,23 @@ void AShooterHUD::DrawWeaponHUD()
 			Canvas->DrawIcon(MyWeapon->PrimaryIcon, PriWeapPosX, PriWeapPosY, ScaleUI);
 
 			const float TextOffset = 12;
-			float SizeX, SizeY;
 			float TopTextHeight;
-			FString Text = FString::FromInt(MyWeapon->GetCurrentAmmoInClip());
-
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			FShooterHUDText Text = GetHUDText(FString::FromInt(MyWeapon->GetCurrentAmmoInClip()), BigFont);
 
 			const float TopTextScale = 0.73f; // of 51pt font
-			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
+			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + Text.Size.X * TopTextScale) / 2.0f)  * ScaleUI;
 			const float TopTextPosY = Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset - TextOffset / 2.0f) * ScaleUI; 
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = Text.Text;
 			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
-			TopTextHeight = SizeY * TopTextScale;
-			Text = FString::FromInt(MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip());
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			TopTextHeight = Text.Size.Y * TopTextScale;
+			Text = GetHUDText(FString::FromInt(MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip()), BigFont);
 
 			const float BottomTextScale = 0.49f; // of 51pt font
-			const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * BottomTextScale) / 2.0f) * ScaleUI; 
+			const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + Text.Size.X * BottomTextScale) / 2.0f) * ScaleUI; 
 			const float BottomTextPosY = TopTextPosY + (TopTextHeight - 0.8f * TextOffset) * ScaleUI;
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = Text.Text;
 			TextItem.Scale = FVector2D( BottomTextScale*ScaleUI, BottomTextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			Canvas->DrawItem( TextItem, BottomTextPosX, BottomTextPosY );
@@ -296,18 +298,16 @@ void AShooterHUD::DrawWeaponHUD()
 			Canvas->DrawIcon(SecondaryWeapon->SecondaryIcon, SecWeapPosX, SecWeapPosY, ScaleUI);
 
 			const float TextOffset = 10;
-			float SizeX, SizeY;
 			float TopTextHeight;
-			FString Text = FString::FromInt(SecondaryWeapon->GetCurrentAmmo());
+			const FShooterHUDText Text = GetHUDText(FString::FromInt(SecondaryWeapon->GetCurrentAmmo()), BigFont);
 
-			Canvas->StrLen(BigFont,Text, SizeX, SizeY);
 			const float TopTextScale = 0.53f; // of 51pt font
-			TopTextHeight = SizeY * TopTextScale;
+			TopTextHeight = Text.Size.Y * TopTextScale;
 
-			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (SecClipBoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
+			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (SecClipBoxWidth + Text.Size.X * TopTextScale) / 2.0f)  * ScaleUI;
 			const float TopTextPosY = SecWeapBgPosY + (SecondaryWeapBg.VL - TopTextHeight) / 2.0f * ScaleUI; 
 
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = Text.Text;
 			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
 			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
 		}
@@ -349,33 +349,30 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 	{
 		FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 		TextItem.EnableShadow( FLinearColor::Black );
-		float SizeX, SizeY;
 		float TextScale = 0.57f;
-		FString Text;
+		FShooterHUDText Text;
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.Scale = FVector2D( TextScale*ScaleUI, TextScale*ScaleUI );
 		if (MyGameState->GetMatchState() == MatchState::WaitingToStart)
 		{
 			TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-			Text = LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime);
+			Text = GetHUDText(LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime), BigFont);
 			TextItem.SetColor( HUDLight );
-			TextItem.Text = FText::FromString( Text );			
+			TextItem.Text = Text.Text;
 			AddMatchInfoString(TextItem);
 		}
 		else if (MyGameState->GetMatchState() == MatchState::InProgress)
 		{
-			Text = GetTimeString(MyGameState->RemainingTime);
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			Text = GetHUDText(GetTimeString(MyGameState->RemainingTime), BigFont);
 
 			TextItem.SetColor( HUDDark );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = Text.Text;
 			TextItem.Position = FVector2D( TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
-				TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				TimerPosY + (TimePlaceBg.VL * ScaleUI - Text.Size.Y * TextScale * ScaleUI) / 2 );
 			Canvas->DrawItem(TextItem);
 		}
 
 		float BoxWidth = 45.0f * ScaleUI;
-		Text = FString();
 		AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(PlayerOwner);
 		if (MyPC && MyGameState && MatchState == EShooterMatchState::Playing)
 		{
@@ -397,33 +394,27 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 					int32 NumTeams = 0;
 					for (int32 i=0; i < MyGameState->NumTeams; i++)
 					{
-						RankedPlayerMap PlayerStateMap;
-						MyGameState->GetRankedMap(i,PlayerStateMap);
-						if(PlayerStateMap.Num() > 0)
+						if (MyGameState->GetRankedPlayers(i).Num() > 0)
 						{
 							NumTeams++;
 						}
 					}
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, NumTeams);
+					Text = GetHUDText(FString::Printf(TEXT("%d/%d"), MyPos, NumTeams), BigFont);
 				}
 				else // free for all
 				{
-					RankedPlayerMap PlayerStateMap;
-					MyGameState->GetRankedMap(0,PlayerStateMap);
-					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
+					const int32 MyPos = MyGameState->GetPlayerRank(MyPlayerState) + 1;
+					Text = GetHUDText(FString::Printf(TEXT("%d/%d"), MyPos, MyGameState->GetRankedPlayers(0).Num()), BigFont);
 				}
-				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
 				Canvas->DrawIcon(PlaceIcon,
-					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (SizeX * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
+					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (Text.Size.X * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
 					TimerPosY + (TimePlaceBg.VL - PlaceIcon.VL) / 2.0f * ScaleUI, ScaleUI);
 
-				TextItem.Text = FText::FromString( Text);
+				TextItem.Text = Text.Text;
 				TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 				TextItem.FontRenderInfo = ShadowedFont;
-				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + SizeX * TextScale * ScaleUI),
-					TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + Text.Size.X * TextScale * ScaleUI),
+					TimerPosY + (TimePlaceBg.VL * ScaleUI - Text.Size.Y * TextScale * ScaleUI) / 2 );
 			}
 		}
 	}
@@ -447,32 +438,22 @@ void AShooterHUD::DrawKills()
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 
-	float SizeX, SizeY;
-	FString Text = LOCTEXT("Kills", "KILLS:").ToString();
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+	FShooterHUDText Text = GetHUDText(LOCTEXT("Kills", "KILLS:").ToString(), BigFont);
 
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = Text.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 	TextItem.FontRenderInfo = ShadowedFont;
 	TextItem.SetColor(HUDDark);
 	Canvas->DrawItem( TextItem, KillsPosX + Offset * ScaleUI + KillsIcon.UL * 1.5f * ScaleUI,
-		KillsPosY + (KillsBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+		KillsPosY + (KillsBg.VL * ScaleUI - Text.Size.Y * TextScale * ScaleUI) / 2 );
 
-	if (MyPlayerState)
-	{
-		Text = FString::FromInt(MyPlayerState->GetKills());
-	}
-	else 
-	{
-		Text = FString("0");
-	}
+	Text = GetHUDText(FString::FromInt(MyPlayerState->GetKills()), BigFont);
 	TextScale = 0.88f;
 	float BoxWidth = 135.0f * ScaleUI;
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = Text.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-	Canvas->DrawItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + SizeX * TextScale * ScaleUI) /2,
-		KillsPosY + (KillsBg.VL* ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+	Canvas->DrawItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + Text.Size.X * TextScale * ScaleUI) /2,
+		KillsPosY + (KillsBg.VL* ScaleUI - Text.Size.Y * TextScale * ScaleUI) / 2 );
 
 }
 
@@ -488,6 +469,8 @@ void AShooterHUD::NotifyEnemyHit()
 
 void AShooterHUD::DrawHUD()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterHUDDraw);
+
 	Super::DrawHUD();
 	if (Canvas == nullptr)
 	{
@@ -582,10 +565,9 @@ void AShooterHUD::DrawHUD()
 		else
 		{
 			// respawn
-			FString Text = LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN").ToString();
 			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN");
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDLight);
@@ -603,14 +585,11 @@ void AShooterHUD::DrawHUD()
 		const float CurrentTime = GetWorld()->GetTimeSeconds();
 		if (CurrentTime - NoAmmoNotifyTime >= 0 && CurrentTime - NoAmmoNotifyTime <= NoAmmoFadeOutTime)
 		{
-			FString Text = FString();
-
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - NoAmmoNotifyTime) / NoAmmoFadeOutTime);
-			Text = LOCTEXT("NoAmmo", "NO AMMO").ToString();
-			
+
 			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = LOCTEXT("NoAmmo", "NO AMMO");
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(FLinearColor(0.75f, 0.125f, 0.125f, Alpha ));
@@ -762,8 +741,7 @@ void AShooterHUD::DrawDeathMessages()
 	const FColor RedTeamColor = FColor(152, 70, 70, 255);
 	const FColor OwnerColor = HUDLight;
 
-	const FString KilledText = LOCTEXT("killed"," killed ").ToString();
-	FVector2D KilledTextSize(0.0f, 0.0f);
+	const FShooterHUDText KilledText = GetHUDText(LOCTEXT("killed"," killed ").ToString(), NormalFont);
 
 	const float GameTime = GetWorld()->GetTimeSeconds();
 	const float LinePadding = 6.0f;
@@ -775,30 +753,25 @@ void AShooterHUD::DrawDeathMessages()
 	// draw messages
 	float CurrentY = InitialY;
 
-	Canvas->StrLen(NormalFont, KilledText, KilledTextSize.X, KilledTextSize.Y);
-
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 	for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
 	{
 		const FDeathMessage& Message = DeathMessages[i];
 		float CurrentX = InitialX;
-		FVector2D KillerSize(0.0f, 0.0f);
-		FVector2D VictimNameSize(0.0f, 0.0f);
 		float TextScale = 1.00f;
-		Canvas->StrLen(NormalFont, Message.KillerDesc, KillerSize.X, KillerSize.Y);
 		TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.SetColor(Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
 
-		TextItem.Text = FText::FromString( Message.KillerDesc );
+		TextItem.Text = Message.KillerText.Text;
 		Canvas->DrawItem(TextItem, CurrentX, CurrentY);
-		CurrentX += KillerSize.X * TextScale * ScaleUI;
+		CurrentX += Message.KillerText.Size.X * TextScale * ScaleUI;
 		
 		if (Message.DamageType.IsValid())
 		{
 			Canvas->SetDrawColor(FColor::White);
-			float ItemSizeY = KilledTextSize.Y * TextScale * ScaleUI;
+			float ItemSizeY = KilledText.Size.Y * TextScale * ScaleUI;
 			Canvas->DrawIcon(Message.DamageType->KillIcon,
 				CurrentX + (OffsetX / 4.0f) * ScaleUI, 
 				CurrentY + (ItemSizeY - Message.DamageType->KillIcon.VL * ScaleUI) / 2.0f, ScaleUI);
@@ -806,21 +779,20 @@ void AShooterHUD::DrawDeathMessages()
 		}
 		else
 		{
-			TextItem.Text = FText::FromString( KilledText );
+			TextItem.Text = KilledText.Text;
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDDark);
 			Canvas->DrawItem( TextItem, CurrentX, CurrentY );
 
-			CurrentX += KilledTextSize.X * TextScale * ScaleUI;
+			CurrentX += KilledText.Size.X * TextScale * ScaleUI;
 		}
 			
 		TextItem.SetColor(Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));		
 
-		Canvas->StrLen(NormalFont, Message.VictimDesc, VictimNameSize.X, VictimNameSize.Y);
-		TextItem.Text = FText::FromString( Message.VictimDesc );
+		TextItem.Text = Message.VictimText.Text;
 		Canvas->DrawItem( TextItem, CurrentX, CurrentY );
-		CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
+		CurrentY -= (KilledText.Size.Y + LinePadding) * TextScale * ScaleUI;
 	}
 }
 
@@ -844,6 +816,8 @@ void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState,
 			FDeathMessage NewMessage;
 			NewMessage.KillerDesc = KillerPlayerState->GetShortPlayerName();
 			NewMessage.VictimDesc = VictimPlayerState->GetShortPlayerName();
+			NewMessage.KillerText = GetHUDText(NewMessage.KillerDesc, NormalFont);
+			NewMessage.VictimText = GetHUDText(NewMessage.VictimDesc, NormalFont);
 			NewMessage.KillerTeamNum = KillerPlayerState->GetTeamNum();
 			NewMessage.VictimTeamNum = VictimPlayerState->GetTeamNum();
 			NewMessage.bKillerIsOwner = MyPlayerState == KillerPlayerState;
@@ -856,7 +830,7 @@ void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState,
 			if (KillerPlayerState == MyPlayerState && VictimPlayerState != MyPlayerState)
 			{
 				LastKillTime = GetWorld()->GetTimeSeconds();
-				CenteredKillMessage = FText::FromString(NewMessage.VictimDesc);
+				CenteredKillMessage = NewMessage.VictimText.Text;
 			}
 		}
 	}
@@ -1124,6 +1098,36 @@ bool AShooterHUD::IsMatchOver() const
 	return GetMatchState() == EShooterMatchState::Lost || GetMatchState() == EShooterMatchState::Won;
 }
 
+FShooterHUDText AShooterHUD::GetHUDText(const FString& String, const UFont* Font)
+{
+	FHUDTextKey Key;
+	Key.String = String;
+	Key.Font = Font;
+
+	if (const FShooterHUDText* CachedText = TextCache.Find(Key))
+	{
+		return *CachedText;
+	}
+
+	if (TextCache.Num() >= MaxCachedHUDTexts)
+	{
+		TextCache.Reset();
+	}
+
+	INC_DWORD_STAT(STAT_ShooterHUDTextMeasurements);
+
+	// same as UCanvas::StrLen, but doesn't need a canvas so death messages can be measured as they come in
+	FShooterHUDText& NewText = TextCache.Add(Key);
+	NewText.Text = FText::FromString(String);
+	if (Font)
+	{
+		FTextSizingParameters Parameters(Font, 1.0f, 1.0f);
+		UCanvas::CanvasStringSize(Parameters, *String);
+		NewText.Size = FVector2D(Parameters.DrawXL, Parameters.DrawYL);
+	}
+	return NewText;
+}
+
 void AShooterHUD::AddMatchInfoString(const FCanvasTextItem InInfoItem )
 {
 	InfoItems.Add(InInfoItem);
@@ -1137,11 +1141,10 @@ float AShooterHUD::ShowInfoItems(float YOffset, float TextScale)
 	for (int32 iItem = 0; iItem < InfoItems.Num() ; iItem++)
 	{
 		float X = 0.0f;
-		float SizeX, SizeY; 
-		Canvas->StrLen(InfoItems[iItem].Font, InfoItems[iItem].Text.ToString(), SizeX, SizeY);
-		X = CanvasCentre - ( SizeX * InfoItems[iItem].Scale.X)/2.0f;
+		const FVector2D Size = GetHUDText(InfoItems[iItem].Text.ToString(), InfoItems[iItem].Font).Size;
+		X = CanvasCentre - ( Size.X * InfoItems[iItem].Scale.X)/2.0f;
 		Canvas->DrawItem(InfoItems[iItem], X, Y);
-		Y += SizeY * InfoItems[iItem].Scale.Y;
+		Y += Size.Y * InfoItems[iItem].Scale.Y;
 	}
 	return Y;
 }
@@ -1157,18 +1160,18 @@ float AShooterHUD::DrawRecentlyKilledPlayer()
 		{
 			FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark);
 			TextItem.EnableShadow(FLinearColor::Black);
-			float SizeX, SizeY;
 			float TextScale = 0.71f;
-			FString Text = CenteredKillMessage.ToString();
+			const FVector2D Size = GetHUDText(CenteredKillMessage.ToString(), BigFont).Size;
+			const float SizeX = Size.X;
+			const float SizeY = Size.Y;
 
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - LastKillTime) / KillFadeOutTime);
 			TextItem.Font = BigFont;
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
 			Canvas->SetDrawColor(255, 255, 255, 255 * Alpha);
 			Canvas->DrawIcon(KilledIcon, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f,
 				DrawPos - (Offset * 4 - SizeY / 2 * TextScale + KilledIcon.VL / 2) * ScaleUI, ScaleUI);
 			TextItem.SetColor(FColor(HUDLight.R, HUDLight.G, HUDLight.B, HUDLight.A*Alpha));
-			TextItem.Text = FText::FromString(Text);
+			TextItem.Text = CenteredKillMessage;
 			TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 			LastYPos = (DrawPos - (Offset * 4 * ScaleUI)) + SizeY;
 			Canvas->DrawItem(TextItem, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f + KilledIcon.UL * ScaleUI,
@@ -3,19 +3,25 @@
 #include "ShooterGame.h"
 #include "SShooterDemoHUD.h"
 #include "Engine/DemoNetDriver.h"
+#include "Online/ShooterReplayEvents.h"
 #include "ShooterStyle.h"
 #include "CoreStyle.h"
 
+/** how long before a kill the kill buttons seek to, so the lead up can be seen */
+static const float KillSeekLeadTime = 2.0f;
+
 /** Widget to represent the main replay timeline bar */
 class SShooterReplayTimeline : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SShooterReplayTimeline)
 		: _DemoDriver(nullptr)
+		, _KillIndex(nullptr)
 		, _BackgroundBrush( FCoreStyle::Get().GetDefaultBrush() )
 		, _IndicatorBrush( FCoreStyle::Get().GetDefaultBrush() )
 		{}
 	SLATE_ARGUMENT(TWeakObjectPtr<UDemoNetDriver>, DemoDriver)
+	SLATE_ARGUMENT(TSharedPtr<FShooterReplayEventIndex>, KillIndex)
 	SLATE_ATTRIBUTE( FMargin, BackgroundPadding )
 	SLATE_ATTRIBUTE( const FSlateBrush*, BackgroundBrush )
 	SLATE_ATTRIBUTE( const FSlateBrush*, IndicatorBrush )
@@ -33,6 +39,9 @@ private:
 	/** The demo net driver underlying the current replay */
 	TWeakObjectPtr<UDemoNetDriver> DemoDriver;
 
+	/** Kills of the replay, drawn as markers on the bar */
+	TSharedPtr<FShooterReplayEventIndex> KillIndex;
+
 	/** The FName of the image resource to show */
 	TAttribute< const FSlateBrush* > BackgroundBrush;
 
@@ -43,6 +52,7 @@ private:
 void SShooterReplayTimeline::Construct(const FArguments& InArgs)
 {
 	DemoDriver = InArgs._DemoDriver;
+	KillIndex = InArgs._KillIndex;
 	BackgroundBrush = InArgs._BackgroundBrush;
 	IndicatorBrush = InArgs._IndicatorBrush;
 
@@ -79,6 +89,28 @@ int32 SShooterReplayTimeline::OnPaint(const FPaintArgs& Args, const FGeometry& A
 
 		const FLinearColor FinalColorAndOpacity( InWidgetStyle.GetColorAndOpacityTint() * ColorAndOpacity.Get() * ImageBrush->GetTint( InWidgetStyle ) );
 
+		// Thin markers for the kills, below the position indicator
+		const float TotalTime = DemoDriver->GetDemoTotalTime();
+		if (KillIndex.IsValid() && TotalTime > 0.0f)
+		{
+			const FVector2D MarkerSize(2.0f, AllottedGeometry.GetLocalSize().Y);
+			const FLinearColor MarkerColor(FinalColorAndOpacity.R, 0.0f, 0.0f, FinalColorAndOpacity.A * 0.75f);
+
+			for (const float KillTime : KillIndex->GetKillTimes())
+			{
+				const FVector2D MarkerOffset(AllottedGeometry.GetLocalSize().X * FMath::Min(KillTime / TotalTime, 1.0f) - MarkerSize.X * 0.5f, 0.0f);
+
+				FSlateDrawElement::MakeBox(
+					OutDrawElements,
+					ParentLayerId + 1,
+					AllottedGeometry.ToPaintGeometry(MarkerOffset, MarkerSize),
+					FCoreStyle::Get().GetDefaultBrush(),
+					DrawEffects,
+					MarkerColor
+				);
+			}
+		}
+
 		// Adjust clipping rect to replay time
 		const float ReplayPercent = DemoDriver->GetDemoCurrentTime() / DemoDriver->GetDemoTotalTime();
 
@@ -89,7 +121,7 @@ int32 SShooterReplayTimeline::OnPaint(const FPaintArgs& Args, const FGeometry& A
 		
 		const FVector2D Offset = Center - ImageBrush->ImageSize * 0.5f;
 
-		const int32 IndicatorLayerId = ParentLayerId + 1;
+		const int32 IndicatorLayerId = ParentLayerId + 2;
 			
 		FSlateDrawElement::MakeBox(
 			OutDrawElements,
@@ -127,6 +159,9 @@ void SShooterDemoHUD::Construct(const FArguments& InArgs)
 	PlayerOwner = InArgs._PlayerOwner;
 	check(PlayerOwner.IsValid());
 
+	KillIndex = MakeShareable(new FShooterReplayEventIndex());
+	KillIndex->Build(PlayerOwner->GetWorld()->GetDemoNetDriver());
+
 	ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -155,6 +190,7 @@ void SShooterDemoHUD::Construct(const FArguments& InArgs)
 				[
 					SNew(SShooterReplayTimeline)
 					.DemoDriver(PlayerOwner->GetWorld()->GetDemoNetDriver())
+					.KillIndex(KillIndex)
 					.BackgroundBrush(FShooterStyle::Get().GetBrush("ShooterGame.ReplayTimelineBorder"))
 					.BackgroundPadding(FMargin(0.0f, 3.0))
 					.IndicatorBrush(FShooterStyle::Get().GetBrush("ShooterGame.ReplayTimelineIndicator"))
@@ -191,14 +227,50 @@ void SShooterDemoHUD::Construct(const FArguments& InArgs)
 			.Padding(FMargin(6.0))
 			.AutoHeight()
 			[
-				SNew(SCheckBox)
-				.IsFocusable(false)
-				.Style(FCoreStyle::Get(), "ToggleButtonCheckbox")
-				.IsChecked(this, &SShooterDemoHUD::IsPauseChecked)
-				.OnCheckStateChanged(this, &SShooterDemoHUD::OnPauseCheckStateChanged)
+				SNew(SHorizontalBox)
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(FMargin(6.0f, 0.0f))
 				[
-					SNew(SImage)
-					.Image(FShooterStyle::Get().GetBrush("ShooterGame.ReplayPauseIcon"))
+					SNew(SButton)
+					.IsFocusable(false)
+					.ToolTipText(NSLOCTEXT("ShooterGame.HUD.Menu", "PreviousKillTooltip", "Jump to the previous kill"))
+					.OnClicked(this, &SShooterDemoHUD::OnPreviousKillClicked)
+					[
+						SNew(STextBlock)
+						.Text(NSLOCTEXT("ShooterGame.HUD.Menu", "PreviousKill", "<< KILL"))
+					]
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SCheckBox)
+					.IsFocusable(false)
+					.Style(FCoreStyle::Get(), "ToggleButtonCheckbox")
+					.IsChecked(this, &SShooterDemoHUD::IsPauseChecked)
+					.OnCheckStateChanged(this, &SShooterDemoHUD::OnPauseCheckStateChanged)
+					[
+						SNew(SImage)
+						.Image(FShooterStyle::Get().GetBrush("ShooterGame.ReplayPauseIcon"))
+					]
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(FMargin(6.0f, 0.0f))
+				[
+					SNew(SButton)
+					.IsFocusable(false)
+					.ToolTipText(NSLOCTEXT("ShooterGame.HUD.Menu", "NextKillTooltip", "Jump to the next kill"))
+					.OnClicked(this, &SShooterDemoHUD::OnNextKillClicked)
+					[
+						SNew(STextBlock)
+						.Text(NSLOCTEXT("ShooterGame.HUD.Menu", "NextKill", "KILL >>"))
+					]
 				]
 			]
 
@@ -304,3 +376,38 @@ void SShooterDemoHUD::OnPauseCheckStateChanged(ECheckBoxState CheckState) const
 		}
 	}
 }
+
+FReply SShooterDemoHUD::OnPreviousKillClicked() const
+{
+	UDemoNetDriver* DemoDriver = PlayerOwner.IsValid() ? PlayerOwner->GetWorld()->GetDemoNetDriver() : nullptr;
+	if (DemoDriver == nullptr || !KillIndex.IsValid())
+	{
+		return FReply::Unhandled();
+	}
+
+	// skip the kill we are currently leading up to, with some slack for the time played since the last jump
+	const float KillTime = KillIndex->FindPreviousKillTime(DemoDriver->GetDemoCurrentTime() + KillSeekLeadTime - 0.5f);
+	if (KillTime >= 0.0f)
+	{
+		DemoDriver->GotoTimeInSeconds(FMath::Max(KillTime - KillSeekLeadTime, 0.0f));
+	}
+
+	return FReply::Handled();
+}
+
+FReply SShooterDemoHUD::OnNextKillClicked() const
+{
+	UDemoNetDriver* DemoDriver = PlayerOwner.IsValid() ? PlayerOwner->GetWorld()->GetDemoNetDriver() : nullptr;
+	if (DemoDriver == nullptr || !KillIndex.IsValid())
+	{
+		return FReply::Unhandled();
+	}
+
+	const float KillTime = KillIndex->FindNextKillTime(DemoDriver->GetDemoCurrentTime() + KillSeekLeadTime);
+	if (KillTime >= 0.0f)
+	{
+		DemoDriver->GotoTimeInSeconds(FMath::Max(KillTime - KillSeekLeadTime, 0.0f));
+	}
+
+	return FReply::Handled();
+}
@@ -6,8 +6,9 @@
 #include "SlateExtras.h"
 
 class APlayerController;
+class FShooterReplayEventIndex;
 
-/** Shows the replay timeline bar, current time and total time of the replay, current playback speed, and a pause toggle button. */
+/** Shows the replay timeline bar with the kills on it, current time and total time of the replay, current playback speed, a pause toggle button and buttons to jump between kills. */
 class SShooterDemoHUD : public SCompoundWidget
 {
 public:
@@ -27,12 +28,21 @@ private:
 
 	TWeakObjectPtr<APlayerController> PlayerOwner;
 
+	/** kills of the replay, for the timeline markers and the kill buttons */
+	TSharedPtr<FShooterReplayEventIndex> KillIndex;
+
 	FText GetCurrentReplayTime() const;
 	FText GetTotalReplayTime() const;
 	FText GetPlaybackSpeed() const;
 
 	ECheckBoxState IsPauseChecked() const;
 	void OnPauseCheckStateChanged(ECheckBoxState CheckState) const;
+
+	/** seek to a little before the previous kill */
+	FReply OnPreviousKillClicked() const;
+
+	/** seek to a little before the next kill */
+	FReply OnNextKillClicked() const;
 };
 
 
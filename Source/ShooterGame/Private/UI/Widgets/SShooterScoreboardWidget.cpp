@@ -16,6 +16,9 @@
 
 #define	NORM_PADDING	(FMargin(5))
 
+DECLARE_CYCLE_STAT(TEXT("Scoreboard Update"), STAT_ShooterScoreboardUpdate, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scoreboard Cells Changed"), STAT_ShooterScoreboardCellsChanged, STATGROUP_Shooter);
+
 void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 {
 	ScoreboardStyle = &FShooterStyle::Get().GetWidgetStyle<FShooterScoreboardStyle>("DefaultShooterScoreboardStyle");
@@ -202,6 +205,12 @@ FText SShooterScoreboardWidget::GetMatchOutcomeText() const
 void SShooterScoreboardWidget::UpdateScoreboardGrid()
 {
 	ScoreboardData->ClearChildren();
+	PlayerRows.Reset();
+	TeamTotals.Reset();
+	TeamTotals.SetNum(PlayerStateMaps.Num());
+	MatchRestartText.Reset();
+	LastRemainingTime = INDEX_NONE;
+
 	for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
 	{
 		//Player rows from each team
@@ -237,7 +246,7 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 					.HAlign(HAlign_Center)
 					[
 						SNew(STextBlock)
-						.Text(this, &SShooterScoreboardWidget::GetMatchOutcomeText)
+						.Text(GetMatchOutcomeText())
 						.TextStyle(FShooterStyle::Get(), "ShooterGame.MenuHeaderTextStyle")
 					]
 				]
@@ -251,8 +260,7 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 					SNew(SBox)
 					.HAlign(HAlign_Center)
 					[
-						SNew(STextBlock)
-						.Text(this, &SShooterScoreboardWidget::GetMatchRestartText)
+						SAssignNew(MatchRestartText, STextBlock)
 						.TextStyle(FShooterStyle::Get(), "ShooterGame.MenuHeaderTextStyle")
 					]
 				]
@@ -274,6 +282,9 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 				]
 			];
 	}
+
+	// the new widgets start out empty
+	UpdateCells();
 }
 
 void SShooterScoreboardWidget::UpdatePlayerStateMaps()
@@ -281,10 +292,14 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 	if (PCOwner.IsValid())
 	{
 		AShooterGameState* const GameState = PCOwner->GetWorld()->GetGameState<AShooterGameState>();
-		if (GameState)
+		const int32 NumTeams = GameState ? FMath::Max(GameState->NumTeams, 1) : 0;
+
+		// nothing to do unless a score, a team or the players changed since the last update
+		if (GameState && (GameState->GetRankingVersion() != LastRankingVersion || PlayerStateMaps.Num() != NumTeams))
 		{
+			LastRankingVersion = GameState->GetRankingVersion();
+
 			bool bRequiresWidgetUpdate = false;
-			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
 			LastTeamPlayerCount.Reset();
 			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
 			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
@@ -297,7 +312,11 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 		
 			for (int32 i = 0; i < NumTeams; i++)
 			{
-				GameState->GetRankedMap(i, PlayerStateMaps[i]);
+				const RankedPlayerList& RankedPlayers = GameState->GetRankedPlayers(i);
+				for (int32 Rank = 0; Rank < RankedPlayers.Num(); Rank++)
+				{
+					PlayerStateMaps[i].Add(Rank, RankedPlayers[Rank]);
+				}
 
 				if (LastTeamPlayerCount.Num() > 0 && PlayerStateMaps[i].Num() != LastTeamPlayerCount[i])
 				{
@@ -316,7 +335,96 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 
 void SShooterScoreboardWidget::Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime )
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterScoreboardUpdate);
+
 	UpdatePlayerStateMaps();
+	UpdateCells();
+}
+
+void SShooterScoreboardWidget::UpdateCells()
+{
+	for (FScoreboardRow& Row : PlayerRows)
+	{
+		AShooterPlayerState* PlayerState = GetSortedPlayerState(Row.TeamPlayer);
+		const bool bDisplayed = ShouldPlayerBeDisplayed(Row.TeamPlayer);
+		if (Row.bDisplayed != bDisplayed)
+		{
+			Row.bDisplayed = bDisplayed;
+			Row.Widget->SetVisibility(bDisplayed ? EVisibility::Visible : EVisibility::Collapsed);
+		}
+
+		if (!bDisplayed)
+		{
+			continue;
+		}
+
+		// ranks move between players as scores change, the row keeps its widgets and only swaps what they show
+		if (Row.PlayerState != PlayerState)
+		{
+			Row.PlayerState = PlayerState;
+			Row.Name->SetText(GetPlayerName(Row.TeamPlayer));
+			INC_DWORD_STAT(STAT_ShooterScoreboardCellsChanged);
+		}
+
+		const bool bOwner = IsOwnerPlayer(Row.TeamPlayer);
+		const bool bSelected = IsSelectedPlayer(Row.TeamPlayer);
+		if (Row.bOwner != bOwner || Row.bSelected != bSelected)
+		{
+			Row.bOwner = bOwner;
+			Row.bSelected = bSelected;
+
+			const FSlateColor BorderColor = GetScoreboardBorderColor(Row.TeamPlayer);
+			Row.NameBorder->SetBorderBackgroundColor(BorderColor);
+			Row.Name->SetColorAndOpacity(GetPlayerColor(Row.TeamPlayer));
+			for (uint8 ColIdx = 0; ColIdx < Row.Cells.Num(); ColIdx++)
+			{
+				Row.Cells[ColIdx].Border->SetBorderBackgroundColor(BorderColor);
+				Row.Cells[ColIdx].Text->SetColorAndOpacity(GetColumnColor(Row.TeamPlayer, ColIdx));
+			}
+		}
+
+		const bool bTalking = IsPlayerTalking(Row.TeamPlayer);
+		if (Row.bTalking != bTalking)
+		{
+			Row.bTalking = bTalking;
+			Row.SpeakerIcon->SetVisibility(bTalking ? EVisibility::Visible : EVisibility::Hidden);
+		}
+
+		for (uint8 ColIdx = 0; ColIdx < Row.Cells.Num(); ColIdx++)
+		{
+			UpdateCell(Row.Cells[ColIdx], GetStatValue(Columns[ColIdx].AttributeGetter, Row.TeamPlayer));
+		}
+	}
+
+	for (uint8 TeamNum = 0; TeamNum < TeamTotals.Num(); TeamNum++)
+	{
+		if (TeamTotals[TeamNum].Text.IsValid())
+		{
+			UpdateCell(TeamTotals[TeamNum], GetStatValue(Columns.Last().AttributeGetter, FTeamPlayer(TeamNum, SpecialPlayerIndex::All)));
+		}
+	}
+
+	if (MatchRestartText.IsValid())
+	{
+		AShooterGameState* const GameState = PCOwner.IsValid() ? PCOwner->GetWorld()->GetGameState<AShooterGameState>() : nullptr;
+		const int32 RemainingTime = GameState ? GameState->RemainingTime : INDEX_NONE;
+		if (RemainingTime != LastRemainingTime)
+		{
+			LastRemainingTime = RemainingTime;
+			MatchRestartText->SetText(GetMatchRestartText());
+		}
+	}
+}
+
+void SShooterScoreboardWidget::UpdateCell(FScoreboardCell& Cell, int32 Value)
+{
+	// text is only formatted, and the cell only invalidated, when the number changes
+	if (Cell.Value != Value)
+	{
+		Cell.Value = Value;
+		Cell.Text->SetText(FText::AsNumber(Value));
+		INC_DWORD_STAT(STAT_ShooterScoreboardCellsChanged);
+	}
 }
 
 bool SShooterScoreboardWidget::SupportsKeyboardFocus() const
@@ -583,12 +691,7 @@ bool SShooterScoreboardWidget::ProfileUIOpened() const
 	return false;
 }
 
-EVisibility SShooterScoreboardWidget::PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const
-{
-	return GetSortedPlayerState(TeamPlayer) ? EVisibility::Visible : EVisibility::Collapsed;
-}
-
-EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const
+bool SShooterScoreboardWidget::IsPlayerTalking(const FTeamPlayer& TeamPlayer) const
 {
 	AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
 	if (PlayerState)
@@ -598,11 +701,11 @@ EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(const FTeamPlayer Te
 		{
 			if (PlayerUniqueId == PlayersTalkingThisFrame[i].Key && PlayersTalkingThisFrame[i].Value)
 			{
-				return EVisibility::Visible;
+				return true;
 			}
 		}
 	}
-	return EVisibility::Hidden;
+	return false;
 }
 
 FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const
@@ -663,7 +766,7 @@ bool SShooterScoreboardWidget::IsOwnerPlayer(const FTeamPlayer& TeamPlayer) cons
 	return ( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == GetSortedPlayerState(TeamPlayer) );
 }
 
-FText SShooterScoreboardWidget::GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const
+int32 SShooterScoreboardWidget::GetStatValue(const FOnGetPlayerStateAttribute& Getter, const FTeamPlayer& TeamPlayer) const
 {
 	int32 StatTotal = 0;
 	if (TeamPlayer.PlayerId != SpecialPlayerIndex::All)
@@ -686,7 +789,7 @@ FText SShooterScoreboardWidget::GetStat(FOnGetPlayerStateAttribute Getter, const
 		}
 	}
 
-	return FText::AsNumber(LerpForCountup(StatTotal));
+	return LerpForCountup(StatTotal);
 }
 
 int32 SShooterScoreboardWidget::LerpForCountup(int32 ScoreValue) const
@@ -702,7 +805,7 @@ int32 SShooterScoreboardWidget::LerpForCountup(int32 ScoreValue) const
 	}
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
+TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum)
 {
 	TSharedPtr<SHorizontalBox> TotalsRow;
 
@@ -754,8 +857,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 			.WidthOverride(ScoreBoxWidth)
 			.HAlign(HAlign_Center)
 			[
-				SNew(STextBlock)
-				.Text(this, &SShooterScoreboardWidget::GetStat, Columns.Last().AttributeGetter, FTeamPlayer(TeamNum, SpecialPlayerIndex::All))
+				SAssignNew(TeamTotals[TeamNum].Text, STextBlock)
 				.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.HeaderTextStyle")
 			]
 		]
@@ -764,82 +866,81 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 	return TotalsRow.ToSharedRef();
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRows(uint8 TeamNum) const
+TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRows(uint8 TeamNum)
 {
-	TSharedRef<SVerticalBox> PlayerRows = SNew(SVerticalBox);
+	TSharedRef<SVerticalBox> TeamRows = SNew(SVerticalBox);
 
+	// a row for every rank, rows of spectators are collapsed by UpdateCells
 	for (int32 PlayerIndex=0; PlayerIndex < PlayerStateMaps[TeamNum].Num(); PlayerIndex++ )
 	{
-		FTeamPlayer TeamPlayer(TeamNum, PlayerIndex);
-
-		if (ShouldPlayerBeDisplayed(TeamPlayer))
-		{
-			PlayerRows->AddSlot().AutoHeight()
-				[
-					MakePlayerRow(TeamPlayer)
-				];
-		}
+		TeamRows->AddSlot().AutoHeight()
+			[
+				MakePlayerRow(FTeamPlayer(TeamNum, PlayerIndex))
+			];
 	}
 
-	return PlayerRows;
+	return TeamRows;
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& TeamPlayer) const
+TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& TeamPlayer)
 {
 	// Make the padding here slightly smaller than NORM_PADDING, to fit in more players
 	const FMargin Pad = FMargin(5,1);
 
+	FScoreboardRow& Row = PlayerRows.AddDefaulted_GetRef();
+	Row.TeamPlayer = TeamPlayer;
+
 	TSharedPtr<SHorizontalBox> PlayerRow;
 	//Speaker Icon display
 	SAssignNew(PlayerRow, SHorizontalBox)
+	.Visibility(EVisibility::Collapsed)
 	+ SHorizontalBox::Slot().Padding(Pad+FMargin(2,0,0,0)).AutoWidth()
 	[
-		SNew(SImage)
+		SAssignNew(Row.SpeakerIcon, SImage)
 		.Image(FShooterStyle::Get().GetBrush("ShooterGame.Speaker"))
-		.Visibility(this, &SShooterScoreboardWidget::SpeakerIconVisibility, TeamPlayer)
+		.Visibility(EVisibility::Hidden)
 	];
+	Row.Widget = PlayerRow;
 
 	//first autosized row with player name
 	PlayerRow->AddSlot() .Padding(Pad)
 	[
-		SNew(SBorder)
+		SAssignNew(Row.NameBorder, SBorder)
 		.Padding(Pad)
 		.HAlign(HAlign_Right)
 		.VAlign(VAlign_Center)
-		.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-		.OnMouseMove(const_cast<SShooterScoreboardWidget*>(this), &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-		.BorderBackgroundColor(const_cast<SShooterScoreboardWidget*>(this), &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
+		.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
+		.BorderBackgroundColor(GetScoreboardBorderColor(TeamPlayer))
 		.BorderImage(&ScoreboardStyle->ItemBorderBrush)
 		[
-			SNew(STextBlock)
-			.Text(this, &SShooterScoreboardWidget::GetPlayerName, TeamPlayer)
+			SAssignNew(Row.Name, STextBlock)
 			.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-			.ColorAndOpacity(this, &SShooterScoreboardWidget::GetPlayerColor, TeamPlayer)
+			.ColorAndOpacity(GetPlayerColor(TeamPlayer))
 		]
 	];
 	//attributes rows (kills, deaths, score/captures)
+	Row.Cells.SetNum(Columns.Num());
 	for (uint8 ColIdx = 0; ColIdx < Columns.Num(); ColIdx++)
 	{
+		FScoreboardCell& Cell = Row.Cells[ColIdx];
 		PlayerRow->AddSlot()
 		.Padding(Pad) .AutoWidth() .HAlign(HAlign_Center) .VAlign(VAlign_Center)
 		[
-			SNew(SBorder)
+			SAssignNew(Cell.Border, SBorder)
 			.Padding(Pad)
 			.VAlign(VAlign_Center)
 			.HAlign(HAlign_Center)
-			.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-			.OnMouseMove(const_cast<SShooterScoreboardWidget*>(this), &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-			.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
+			.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
+			.BorderBackgroundColor(GetScoreboardBorderColor(TeamPlayer))
 			.BorderImage(&ScoreboardStyle->ItemBorderBrush)
 			[
 				SNew(SBox)
 				.WidthOverride(ScoreBoxWidth)
 				.HAlign(HAlign_Center)
 				[
-					SNew(STextBlock)
-					.Text(this, &SShooterScoreboardWidget::GetStat, Columns[ColIdx].AttributeGetter, TeamPlayer)
+					SAssignNew(Cell.Text, STextBlock)
 					.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-					.ColorAndOpacity(this, &SShooterScoreboardWidget::GetColumnColor, TeamPlayer, ColIdx)
+					.ColorAndOpacity(GetColumnColor(TeamPlayer, ColIdx))
 				]
 			]
 		];
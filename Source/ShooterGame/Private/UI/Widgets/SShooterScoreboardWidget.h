@@ -71,6 +71,29 @@ struct FTeamPlayer
 	}
 };
 
+/** a stat cell of the scoreboard and the value it shows, so its text is only formatted when the value changes */
+struct FScoreboardCell
+{
+	TSharedPtr<STextBlock> Text;
+	TSharedPtr<SBorder> Border;
+	int32 Value = MIN_int32;
+};
+
+/** widgets of a scoreboard row and what they currently show */
+struct FScoreboardRow
+{
+	FTeamPlayer TeamPlayer;
+	TSharedPtr<SWidget> Widget;
+	TSharedPtr<SImage> SpeakerIcon;
+	TSharedPtr<SBorder> NameBorder;
+	TSharedPtr<STextBlock> Name;
+	TArray<FScoreboardCell, TInlineAllocator<4>> Cells;
+	TWeakObjectPtr<AShooterPlayerState> PlayerState;
+	bool bDisplayed = false;
+	bool bOwner = false;
+	bool bSelected = false;
+	bool bTalking = false;
+};
 
 //class declare
 class SShooterScoreboardWidget : public SBorder
@@ -88,7 +111,7 @@ class SShooterScoreboardWidget : public SBorder
 	/** needed for every widget */
 	void Construct(const FArguments& InArgs);
 
-	/** update PlayerState maps with every tick when scoreboard is shown */
+	/** update PlayerState maps and the cells that changed with every tick when scoreboard is shown */
 	virtual void Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime ) override;
 
 	/** if we want to receive focus */
@@ -109,28 +132,28 @@ protected:
 	void UpdateScoreboardGrid();
 
 	/** makes total row widget */
-	TSharedRef<SWidget> MakeTotalsRow(uint8 TeamNum) const;
+	TSharedRef<SWidget> MakeTotalsRow(uint8 TeamNum);
 
 	/** makes player rows */
-	TSharedRef<SWidget> MakePlayerRows(uint8 TeamNum) const;
+	TSharedRef<SWidget> MakePlayerRows(uint8 TeamNum);
 
 	/** makes player row */
-	TSharedRef<SWidget> MakePlayerRow(const FTeamPlayer& TeamPlayer) const;
+	TSharedRef<SWidget> MakePlayerRow(const FTeamPlayer& TeamPlayer);
+
+	/** pushes new values, names, colors and visibilities to the widgets whose content changed */
+	void UpdateCells();
+
+	/** sets the text of the cell if the value changed */
+	void UpdateCell(FScoreboardCell& Cell, int32 Value);
 
 	/** updates PlayerState maps to display accurate scores */
 	void UpdatePlayerStateMaps();
 
-	/** gets ranked map for specific team */
-	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;
-
 	/** gets PlayerState for specific team and player */
 	AShooterPlayerState* GetSortedPlayerState(const FTeamPlayer& TeamPlayer) const;
 
-	/** get player visibility */
-	EVisibility PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const;
-
-	/** get speaker icon visibility */
-	EVisibility SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const;
+	/** is the player talking right now */
+	bool IsPlayerTalking(const FTeamPlayer& TeamPlayer) const;
 
 	/** get scoreboard border color */
 	FSlateColor GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const;
@@ -151,7 +174,7 @@ protected:
 	bool IsOwnerPlayer(const FTeamPlayer& TeamPlayer) const;
 
 	/** get specific stat for team number and optionally player */
-	FText GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const;
+	int32 GetStatValue(const FOnGetPlayerStateAttribute& Getter, const FTeamPlayer& TeamPlayer) const;
 
 	/** linear interpolated score for match outcome animation */
 	int32 LerpForCountup(int32 ScoreValue) const;
@@ -219,9 +242,12 @@ protected:
 	/** the player currently selected in the scoreboard */
 	FTeamPlayer SelectedPlayer;
 
-	/** the Ranked PlayerState map...cleared every frame */
+	/** the Ranked PlayerState map...refilled whenever the game state's ranking changes */
 	TArray<RankedPlayerMap> PlayerStateMaps;
 
+	/** ranking version of the game state PlayerStateMaps were filled from */
+	uint32 LastRankingVersion = 0;
+
 	/** player count in each team in the last tick */
 	TArray<int32> LastTeamPlayerCount;
 
@@ -231,6 +257,18 @@ protected:
 	/** holds player info rows */
 	TSharedPtr<SVerticalBox> ScoreboardData;
 
+	/** player rows of all teams, rebuilt only when players leave or join */
+	TArray<FScoreboardRow> PlayerRows;
+
+	/** team score cell per team, only set in team games */
+	TArray<FScoreboardCell> TeamTotals;
+
+	/** match restart countdown, only shown after the match */
+	TSharedPtr<STextBlock> MatchRestartText;
+
+	/** remaining time MatchRestartText was formatted with */
+	int32 LastRemainingTime = INDEX_NONE;
+
 	/** stat columns data */
 	TArray<FColumnData> Columns;
 
@@ -46,10 +46,15 @@ void AShooterProjectile::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	CollisionComp->MoveIgnoreActors.Add(GetInstigator());
-
 	CollisionComp->OnComponentHit.AddDynamic(this, &AShooterProjectile::OnHit);
 
+	InitProjectile();
+}
+
+void AShooterProjectile::InitProjectile()
+{
+	CollisionComp->MoveIgnoreActors.Reset();
+	CollisionComp->MoveIgnoreActors.Add(GetInstigator());
 
 	if (FreezeProjectile)
 	{
@@ -70,9 +75,55 @@ void AShooterProjectile::PostInitializeComponents()
 		SetLifeSpan(WeaponConfig.ProjectileLife);
 	}
 
+	MyController = GetInstigatorController();
+}
+
+void AShooterProjectile::LifeSpanExpired()
+{
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		UShooterActorPool::ReleaseOrDestroy(this);
+	}
+	else
+	{
+		Super::LifeSpanExpired();
+	}
+}
 
+void AShooterProjectile::OnAcquiredFromPool()
+{
+	// released actors always have their movement stopped, prewarmed ones and expired ones included
+	bExploded = false;
+	ResetForReuse();
 
-	MyController = GetInstigatorController();
+	// owner and instigator change with every use
+	InitProjectile();
+}
+
+void AShooterProjectile::OnReleasedToPool()
+{
+	MovementComp->StopMovementImmediately();
+	MovementComp->SetComponentTickEnabled(false);
+}
+
+void AShooterProjectile::ResetForReuse()
+{
+	// an impact detaches the updated component on the server and on clients alike
+	MovementComp->SetUpdatedComponent(CollisionComp);
+	MovementComp->SetComponentTickEnabled(true);
+
+	Mesh->SetActive(true);
+
+	if (ParticleComp && ParticleComp->bAutoActivate)
+	{
+		ParticleComp->Activate(true);
+	}
+
+	UAudioComponent* ProjAudioComp = FindComponentByClass<UAudioComponent>();
+	if (ProjAudioComp && ProjAudioComp->bAutoActivate)
+	{
+		ProjAudioComp->Play();
+	}
 }
 
 void AShooterProjectile::InitVelocity(FVector& ShootDirection)
@@ -122,14 +173,15 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 	}
 
 
-	if (ExplosionTemplate)
+	UShooterActorPool* Pool = UShooterActorPool::Get(this);
+	if (ExplosionTemplate && Pool)
 	{
 		FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), NudgedImpactLocation);
-		AShooterExplosionEffect* const EffectActor = GetWorld()->SpawnActorDeferred<AShooterExplosionEffect>(ExplosionTemplate, SpawnTransform);
+		AShooterExplosionEffect* const EffectActor = Pool->BeginAcquire<AShooterExplosionEffect>(ExplosionTemplate, SpawnTransform);
 		if (EffectActor)
 		{
 			EffectActor->SurfaceHit = Impact;
-			UGameplayStatics::FinishSpawningActor(EffectActor, SpawnTransform);
+			Pool->FinishAcquire(EffectActor, SpawnTransform);
 		}
 	}
 
@@ -196,7 +248,7 @@ void AShooterProjectile::DisableAndDestroy()
 
 	MovementComp->StopMovementImmediately();
 
-	// give clients some time to show explosion
+	// give clients some time to show explosion, then go back to the pool
 	Mesh->SetActive(false);
 	SetLifeSpan(2.0f);
 }
@@ -204,6 +256,13 @@ void AShooterProjectile::DisableAndDestroy()
 ///CODE_SNIPPET_START: AActor::GetActorLocation AActor::GetActorRotation
 void AShooterProjectile::OnRep_Exploded()
 {
+	// the server took this projectile out of the pool again
+	if (!bExploded)
+	{
+		ResetForReuse();
+		return;
+	}
+
 	FVector ProjDirection = GetActorForwardVector();
 
 	const FVector StartTrace = GetActorLocation() - ProjDirection * 200;
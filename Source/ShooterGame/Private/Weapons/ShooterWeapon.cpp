@@ -3,6 +3,7 @@
 #include "ShooterGame.h"
 #include "Weapons/ShooterWeapon.h"
 #include "Player/ShooterCharacter.h"
+#include "Weapons/ShooterProjectile.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Bots/ShooterAIController.h"
 #include "Online/ShooterPlayerState.h"
@@ -63,6 +64,19 @@ void AShooterWeapon::PostInitializeComponents()
 		CurrentAmmo = WeaponConfig.AmmoPerClip * WeaponConfig.InitialClips;
 	}
 
+	if (AShooterCharacter::ShouldBeServerLean(this))
+	{
+		// the 1st person mesh is the root, keep the component for the 3rd person one to hang off but drop its mesh,
+		// the 3rd person mesh has nothing to animate and is only needed for its muzzle socket.
+		// the ticks must not start enabled, BeginPlay registers them and would turn them back on
+		Mesh1P->SetSkeletalMesh(nullptr);
+		Mesh1P->PrimaryComponentTick.bStartWithTickEnabled = false;
+		Mesh1P->SetComponentTickEnabled(false);
+		Mesh3P->PrimaryComponentTick.bStartWithTickEnabled = false;
+		Mesh3P->SetComponentTickEnabled(false);
+		Mesh3P->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+
 	DetachMeshFromPawn();
 }
 
@@ -391,14 +405,15 @@ void AShooterWeapon::UseAmmo()
 	}
 
 	AShooterAIController* BotAI = MyPawn ? Cast<AShooterAIController>(MyPawn->GetController()) : NULL;	
-	AShooterPlayerController* PlayerController = MyPawn ? Cast<AShooterPlayerController>(MyPawn->GetController()) : NULL;
 	if (BotAI)
 	{
 		BotAI->CheckAmmo(this);
 	}
-	else if(PlayerController)
+
+	// bots count their shots too, replays read them from the player states
+	AShooterPlayerState* PlayerState = MyPawn ? Cast<AShooterPlayerState>(MyPawn->GetPlayerState()) : NULL;
+	if (PlayerState)
 	{
-		AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(PlayerController->PlayerState);
 		switch (GetAmmoType())
 		{
 			case EAmmoType::ERocket:
@@ -429,6 +444,8 @@ void AShooterWeapon::HandleReFiring()
 
 void AShooterWeapon::HandleFiring()
 {
+	bool bFiredShot = false;
+
 	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
 		if (GetNetMode() != NM_DedicatedServer)
@@ -444,6 +461,8 @@ void AShooterWeapon::HandleFiring()
 			
 			// update firing FX on remote clients if function was called on server
 			BurstCounter++;
+
+			bFiredShot = true;
 		}
 	}
 	else if (CanReload())
@@ -476,8 +495,8 @@ void AShooterWeapon::HandleFiring()
 
 	if (MyPawn && MyPawn->IsLocallyControlled())
 	{
-		// local client will notify server
-		if (GetLocalRole() < ROLE_Authority)
+		// local client will notify server, unless the shot is already on its way in a batch
+		if (GetLocalRole() < ROLE_Authority && !(bFiredShot && UsesShotBatching()))
 		{
 			ServerHandleFiring();
 		}
@@ -506,6 +525,11 @@ bool AShooterWeapon::ServerHandleFiring_Validate()
 }
 
 void AShooterWeapon::ServerHandleFiring_Implementation()
+{
+	HandleServerFiring();
+}
+
+void AShooterWeapon::HandleServerFiring()
 {
 	const bool bShouldUpdateAmmo = (CurrentAmmoInClip > 0 && CanFire());
 
@@ -625,6 +649,21 @@ void AShooterWeapon::OnBurstFinished()
 //////////////////////////////////////////////////////////////////////////
 // Weapon usage helpers
 
+void AShooterWeapon::GetPooledActorClasses(TArray<UClass*>& OutClasses) const
+{
+	UClass* ProjectileClass = GetProjectileClass();
+	if (ProjectileClass)
+	{
+		OutClasses.AddUnique(ProjectileClass);
+
+		UClass* ExplosionClass = ProjectileClass->GetDefaultObject<AShooterProjectile>()->GetExplosionTemplate();
+		if (ExplosionClass)
+		{
+			OutClasses.AddUnique(ExplosionClass);
+		}
+	}
+}
+
 UAudioComponent* AShooterWeapon::PlayWeaponSound(USoundCue* Sound)
 {
 	UAudioComponent* AC = NULL;
@@ -737,12 +776,23 @@ FVector AShooterWeapon::GetCameraDamageStartLocation(const FVector& AimDir) cons
 
 FVector AShooterWeapon::GetMuzzleLocation() const
 {
+	// the muzzle follows the pawn's hands, which lean servers only pose on demand
+	if (MyPawn)
+	{
+		MyPawn->RefreshServerPose();
+	}
+
 	USkeletalMeshComponent* UseMesh = GetWeaponMesh();
 	return UseMesh->GetSocketLocation(MuzzleAttachPoint);
 }
 
 FVector AShooterWeapon::GetMuzzleDirection() const
 {
+	if (MyPawn)
+	{
+		MyPawn->RefreshServerPose();
+	}
+
 	USkeletalMeshComponent* UseMesh = GetWeaponMesh();
 	return UseMesh->GetSocketRotation(MuzzleAttachPoint).Vector();
 }
@@ -5,9 +5,110 @@
 #include "Particles/ParticleSystemComponent.h"
 #include "Effects/ShooterImpactEffect.h"
 
+DECLARE_CYCLE_STAT(TEXT("Hit Validation"), STAT_ShooterHitValidation, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rewound Hits"), STAT_ShooterRewoundHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rejected Hits"), STAT_ShooterRejectedHits, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Shot Batch"), STAT_ShooterShotBatch, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Shots"), STAT_ShooterBatchedShots, STATGROUP_Shooter);
+
+/** most shots sent in one ServerFireShots, more pending shots go out in several batches */
+static const int32 MaxShotsPerBatch = 32;
+
+static int32 NetEnableLagCompensation = 1;
+FAutoConsoleVariableRef CVarNetEnableLagCompensation(
+	TEXT("p.NetEnableLagCompensation"),
+	NetEnableLagCompensation,
+	TEXT("Validate client side hits on characters against their pose at the time the client fired.\n")
+	TEXT("0: Disable (use current bounding box), 1: Enable"),
+	ECVF_Default);
+
+static float NetLagCompensationMaxRewind = 0.4f;
+FAutoConsoleVariableRef CVarNetLagCompensationMaxRewind(
+	TEXT("p.NetLagCompensationMaxRewind"),
+	NetLagCompensationMaxRewind,
+	TEXT("Maximum time (in seconds) the server will rewind a character to validate a client side hit."),
+	ECVF_Default);
+
+static float NetShotBatchResendInterval = 0.1f;
+FAutoConsoleVariableRef CVarNetShotBatchResendInterval(
+	TEXT("p.NetShotBatchResendInterval"),
+	NetShotBatchResendInterval,
+	TEXT("How long (in seconds) a client waits for the server to acknowledge its shots before sending them again."),
+	ECVF_Default);
+
+static float NetShotMaxAge = 1.0f;
+FAutoConsoleVariableRef CVarNetShotMaxAge(
+	TEXT("p.NetShotMaxAge"),
+	NetShotMaxAge,
+	TEXT("How far (in seconds) the time stamp of a client side hit may be from the server time, hits further off are rejected."),
+	ECVF_Default);
+
+bool FInstantShotData::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint8 bHit = bBlockingHit;
+	Ar.SerializeBits(&bHit, 1);
+	bBlockingHit = bHit;
+
+	bool bLocalSuccess = true;
+	ShootDir.NetSerialize(Ar, Map, bLocalSuccess);
+	bOutSuccess &= bLocalSuccess;
+
+	Ar << RandomSeed;
+	Ar << QuantizedSpread;
+	Ar << TimeOffset;
+
+	// misses only need enough to replay the trail FX
+	if (bBlockingHit)
+	{
+		ImpactPoint.NetSerialize(Ar, Map, bLocalSuccess);
+		bOutSuccess &= bLocalSuccess;
+
+		ImpactNormal.NetSerialize(Ar, Map, bLocalSuccess);
+		bOutSuccess &= bLocalSuccess;
+
+		UObject* HitObject = HitActor;
+		bOutSuccess &= Map->SerializeObject(Ar, AActor::StaticClass(), HitObject);
+		HitActor = Cast<AActor>(HitObject);
+	}
+
+	return true;
+}
+
 AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	CurrentFiringSpread = 0.0f;
+	NumUnsentShots = 0;
+	LastShotBatchSendTime = 0.0f;
+	LastProcessedShotSequence = -1;
+}
+
+void AShooterWeapon_Instant::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// shots fired since the last tick go out together, each one keeps the time stamp it was fired with
+	FlushShots();
+}
+
+void AShooterWeapon_Instant::StopFire()
+{
+	// the server must see the last shots of the burst before it stops firing
+	FlushShots();
+
+	Super::StopFire();
+}
+
+void AShooterWeapon_Instant::StartReload(bool bFromReplication)
+{
+	// the server must see the shots that emptied the clip before it reloads
+	if (!bFromReplication)
+	{
+		FlushShots();
+	}
+
+	Super::StartReload(bFromReplication);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -31,12 +132,127 @@ void AShooterWeapon_Instant::FireWeapon()
 	CurrentFiringSpread = FMath::Min(InstantConfig.FiringSpreadMax, CurrentFiringSpread + InstantConfig.FiringSpreadIncrement);
 }
 
-bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+void AShooterWeapon_Instant::QueueShot(const FHitResult& Impact, bool bNotifyHit, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
 {
-	return true;
+	FInstantShotData& Shot = PendingShotBatch.Shots.AddDefaulted_GetRef();
+	Shot.ShootDir = ShootDir;
+	Shot.RandomSeed = RandomSeed;
+	Shot.QuantizedSpread = (uint16)FMath::Clamp(FMath::RoundToInt(ReticleSpread * 100.0f), 0, (int32)MAX_uint16);
+	Shot.bBlockingHit = bNotifyHit;
+	if (bNotifyHit)
+	{
+		Shot.ImpactPoint = Impact.Location;
+		Shot.ImpactNormal = Impact.ImpactNormal;
+		Shot.HitActor = Impact.GetActor();
+	}
+
+	PendingShotTimeStamps.Add(GetClientTimeStamp());
+	NumUnsentShots++;
+
+	// every shot already used ammo locally, send a full batch right away instead of letting it grow
+	if (NumUnsentShots >= MaxShotsPerBatch)
+	{
+		FlushShots();
+	}
+}
+
+void AShooterWeapon_Instant::FlushShots()
+{
+	if (PendingShotBatch.Shots.Num() == 0)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (NumUnsentShots == 0 && Now - LastShotBatchSendTime < NetShotBatchResendInterval)
+	{
+		return;
+	}
+
+	// the server takes at most MaxShotsPerBatch shots at once, while it is behind on acks send the rest in more batches
+	const int32 NumShots = PendingShotBatch.Shots.Num();
+	for (int32 FirstIdx = 0; FirstIdx < NumShots; FirstIdx += MaxShotsPerBatch)
+	{
+		const int32 NumBatchShots = FMath::Min(MaxShotsPerBatch, NumShots - FirstIdx);
+		FInstantShotBatch SplitBatch;
+		FInstantShotBatch& Batch = (NumBatchShots < NumShots) ? SplitBatch : PendingShotBatch;
+		if (NumBatchShots < NumShots)
+		{
+			Batch.FirstShotSequence = PendingShotBatch.FirstShotSequence + FirstIdx;
+			Batch.Shots.Append(PendingShotBatch.Shots.GetData() + FirstIdx, NumBatchShots);
+		}
+
+		// time stamps are relative to the oldest shot of the batch, which changes as shots get acknowledged
+		Batch.ClientTimeStamp = PendingShotTimeStamps[FirstIdx];
+		for (int32 ShotIdx = 0; ShotIdx < NumBatchShots; ShotIdx++)
+		{
+			const int32 TimeOffset = FMath::RoundToInt((PendingShotTimeStamps[FirstIdx + ShotIdx] - Batch.ClientTimeStamp) * 1000.0f);
+			Batch.Shots[ShotIdx].TimeOffset = (uint16)FMath::Clamp(TimeOffset, 0, (int32)MAX_uint16);
+		}
+
+		ServerFireShots(Batch);
+	}
+
+	NumUnsentShots = 0;
+	LastShotBatchSendTime = Now;
+}
+
+bool AShooterWeapon_Instant::ServerFireShots_Validate(const FInstantShotBatch& Batch)
+{
+	return Batch.Shots.Num() <= MaxShotsPerBatch;
+}
+
+void AShooterWeapon_Instant::ServerFireShots_Implementation(const FInstantShotBatch& Batch)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterShotBatch);
+
+	for (int32 ShotIdx = 0; ShotIdx < Batch.Shots.Num(); ShotIdx++)
+	{
+		// shots up to the last one processed are resends of batches we already got
+		const int32 ShotSequence = Batch.FirstShotSequence + ShotIdx;
+		if (ShotSequence <= LastProcessedShotSequence)
+		{
+			continue;
+		}
+		LastProcessedShotSequence = ShotSequence;
+
+		INC_DWORD_STAT(STAT_ShooterBatchedShots);
+
+		const FInstantShotData& Shot = Batch.Shots[ShotIdx];
+		const float ReticleSpread = Shot.GetReticleSpread();
+		if (Shot.bBlockingHit)
+		{
+			FHitResult Impact(Shot.HitActor, NULL, Shot.ImpactPoint, Shot.ImpactNormal);
+			Impact.bBlockingHit = true;
+
+			const float ClientTimeStamp = Batch.ClientTimeStamp + Shot.TimeOffset / 1000.0f;
+			ProcessClientHit(Impact, Shot.ShootDir, Shot.RandomSeed, ReticleSpread, ClientTimeStamp);
+		}
+		else
+		{
+			ProcessClientMiss(Shot.ShootDir, Shot.RandomSeed, ReticleSpread);
+		}
+
+		// fire & update ammo, as ServerHandleFiring would have for this shot
+		HandleServerFiring();
+	}
+
+	ClientAckShots(LastProcessedShotSequence);
 }
 
-void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+void AShooterWeapon_Instant::ClientAckShots_Implementation(int32 LastShotSequence)
+{
+	const int32 NumAcked = FMath::Clamp(LastShotSequence - PendingShotBatch.FirstShotSequence + 1, 0, PendingShotBatch.Shots.Num());
+	if (NumAcked > 0)
+	{
+		PendingShotBatch.Shots.RemoveAt(0, NumAcked, false);
+		PendingShotTimeStamps.RemoveAt(0, NumAcked, false);
+		PendingShotBatch.FirstShotSequence += NumAcked;
+		NumUnsentShots = FMath::Min(NumUnsentShots, PendingShotBatch.Shots.Num());
+	}
+}
+
+void AShooterWeapon_Instant::ProcessClientHit(const FHitResult& Impact, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread, float ClientTimeStamp)
 {
 	const float WeaponAngleDot = FMath::Abs(FMath::Sin(ReticleSpread * PI / 180.f));
 
@@ -50,7 +266,9 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 		const float ViewDotHitDir = FVector::DotProduct(GetInstigator()->GetViewRotation().Vector(), ViewDir);
 		if (ViewDotHitDir > InstantConfig.AllowedViewDotHitDir - WeaponAngleDot)
 		{
-			if (CurrentState != EWeaponState::Idle)
+			// batches are unreliable and may land after ServerStopFire, judge the shot by when it was fired instead of the current state
+			const float Now = GetWorld()->GetTimeSeconds();
+			if (ClientTimeStamp >= Now - NetShotMaxAge && ClientTimeStamp <= Now + NetShotMaxAge)
 			{
 				if (Impact.GetActor() == NULL)
 				{
@@ -65,36 +283,21 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 				{
 					ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 				}
+				else if (IsClientHitWithinTolerance(Impact, ClientTimeStamp))
+				{
+					ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+				}
 				else
 				{
-					// Get the component bounding box
-					const FBox HitBox = Impact.GetActor()->GetComponentsBoundingBox();
-
-					// calculate the box extent, and increase by a leeway
-					FVector BoxExtent = 0.5 * (HitBox.Max - HitBox.Min);
-					BoxExtent *= InstantConfig.ClientSideHitLeeway;
-
-					// avoid precision errors with really thin objects
-					BoxExtent.X = FMath::Max(20.0f, BoxExtent.X);
-					BoxExtent.Y = FMath::Max(20.0f, BoxExtent.Y);
-					BoxExtent.Z = FMath::Max(20.0f, BoxExtent.Z);
-
-					// Get the box center
-					const FVector BoxCenter = (HitBox.Min + HitBox.Max) * 0.5;
-
-					// if we are within client tolerance
-					if (FMath::Abs(Impact.Location.Z - BoxCenter.Z) < BoxExtent.Z &&
-						FMath::Abs(Impact.Location.X - BoxCenter.X) < BoxExtent.X &&
-						FMath::Abs(Impact.Location.Y - BoxCenter.Y) < BoxExtent.Y)
-					{
-						ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
-					}
-					else
-					{
-						UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (outside bounding box tolerance)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
-					}
+					INC_DWORD_STAT(STAT_ShooterRejectedHits);
+					UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (outside bounding box tolerance)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
 				}
 			}
+			else
+			{
+				INC_DWORD_STAT(STAT_ShooterRejectedHits);
+				UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (fired %.2fs away from the server time)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()), Now - ClientTimeStamp);
+			}
 		}
 		else if (ViewDotHitDir <= InstantConfig.AllowedViewDotHitDir)
 		{
@@ -107,12 +310,76 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 	}
 }
 
-bool AShooterWeapon_Instant::ServerNotifyMiss_Validate(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+bool AShooterWeapon_Instant::IsClientHitWithinTolerance(const FHitResult& Impact, float ClientTimeStamp) const
 {
-	return true;
+	SCOPE_CYCLE_COUNTER(STAT_ShooterHitValidation);
+
+	const AShooterCharacter* HitPawn = Cast<AShooterCharacter>(Impact.GetActor());
+	if (NetEnableLagCompensation && HitPawn)
+	{
+		// never rewind further than allowed, a client can't claim to be seeing an arbitrarily old world
+		const float Now = GetWorld()->GetTimeSeconds();
+		const float RewindTime = FMath::Clamp(ClientTimeStamp, Now - NetLagCompensationMaxRewind, Now);
+
+		FVector CapsuleLocation;
+		FBox Hitbox;
+		if (HitPawn->GetRewindHistory().GetPoseAtTime(RewindTime, CapsuleLocation, Hitbox))
+		{
+			INC_DWORD_STAT(STAT_ShooterRewoundHits);
+
+			const float Leeway = InstantConfig.LagCompensationLeeway;
+			if (Hitbox.ExpandBy(Leeway).IsInsideOrOn(Impact.Location))
+			{
+				return true;
+			}
+
+			// the mesh bounds can lag behind a pose change, also accept anything on the rewound capsule
+			const UCapsuleComponent* Capsule = HitPawn->GetCapsuleComponent();
+			const float HalfSegment = Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+			const FVector SegmentStart = CapsuleLocation - FVector(0.f, 0.f, HalfSegment);
+			const FVector SegmentEnd = CapsuleLocation + FVector(0.f, 0.f, HalfSegment);
+			return FMath::PointDistToSegment(Impact.Location, SegmentStart, SegmentEnd) <= Capsule->GetScaledCapsuleRadius() + Leeway;
+		}
+	}
+
+	// no history for this actor, fall back to its current bounding box
+	const FBox HitBox = Impact.GetActor()->GetComponentsBoundingBox();
+
+	// calculate the box extent, and increase by the same leeway as the rewound poses
+	FVector BoxExtent = 0.5 * (HitBox.Max - HitBox.Min);
+	BoxExtent += FVector(InstantConfig.LagCompensationLeeway);
+
+	// avoid precision errors with really thin objects
+	BoxExtent.X = FMath::Max(20.0f, BoxExtent.X);
+	BoxExtent.Y = FMath::Max(20.0f, BoxExtent.Y);
+	BoxExtent.Z = FMath::Max(20.0f, BoxExtent.Z);
+
+	// Get the box center
+	const FVector BoxCenter = (HitBox.Min + HitBox.Max) * 0.5;
+
+	// if we are within client tolerance
+	return FMath::Abs(Impact.Location.Z - BoxCenter.Z) < BoxExtent.Z &&
+		FMath::Abs(Impact.Location.X - BoxCenter.X) < BoxExtent.X &&
+		FMath::Abs(Impact.Location.Y - BoxCenter.Y) < BoxExtent.Y;
+}
+
+float AShooterWeapon_Instant::GetClientTimeStamp() const
+{
+	// the replicated server time is as old as the replicated poses of everyone else
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	float TimeStamp = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+
+	// but the client aimed at where they are drawn, which is smoothed towards the replicated pose and about one smoothing time behind it
+	const UCharacterMovementComponent* MovementComp = MyPawn ? MyPawn->GetCharacterMovement() : nullptr;
+	if (MovementComp && MovementComp->NetworkSmoothingMode != ENetworkSmoothingMode::Disabled)
+	{
+		TimeStamp -= MovementComp->NetworkSimulatedSmoothLocationTime;
+	}
+
+	return TimeStamp;
 }
 
-void AShooterWeapon_Instant::ServerNotifyMiss_Implementation(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
+void AShooterWeapon_Instant::ProcessClientMiss(const FVector& ShootDir, int32 RandomSeed, float ReticleSpread)
 {
 	const FVector Origin = GetMuzzleLocation();
 
@@ -133,25 +400,9 @@ void AShooterWeapon_Instant::ProcessInstantHit(const FHitResult& Impact, const F
 {
 	if (MyPawn && MyPawn->IsLocallyControlled() && GetNetMode() == NM_Client)
 	{
-		// if we're a client and we've hit something that is being controlled by the server
-		if (Impact.GetActor() && Impact.GetActor()->GetRemoteRole() == ROLE_Authority)
-		{
-			// notify the server of the hit
-			ServerNotifyHit(Impact, ShootDir, RandomSeed, ReticleSpread);
-		}
-		else if (Impact.GetActor() == NULL)
-		{
-			if (Impact.bBlockingHit)
-			{
-				// notify the server of the hit
-				ServerNotifyHit(Impact, ShootDir, RandomSeed, ReticleSpread);
-			}
-			else
-			{
-				// notify server of the miss
-				ServerNotifyMiss(ShootDir, RandomSeed, ReticleSpread);
-			}
-		}
+		// the server verifies hits on actors it controls and on the world, anything else only needs the trail FX of a miss
+		const bool bNotifyHit = Impact.GetActor() ? Impact.GetActor()->GetRemoteRole() == ROLE_Authority : Impact.bBlockingHit;
+		QueueShot(Impact, bNotifyHit, ShootDir, RandomSeed, ReticleSpread);
 	}
 
 	// process a confirmed hit
@@ -223,6 +474,14 @@ void AShooterWeapon_Instant::OnBurstFinished()
 //////////////////////////////////////////////////////////////////////////
 // Weapon usage helpers
 
+void AShooterWeapon_Instant::GetPooledActorClasses(TArray<UClass*>& OutClasses) const
+{
+	if (ImpactTemplate)
+	{
+		OutClasses.AddUnique(ImpactTemplate);
+	}
+}
+
 float AShooterWeapon_Instant::GetCurrentSpread() const
 {
 	float FinalSpread = InstantConfig.WeaponSpread + CurrentFiringSpread;
@@ -280,12 +539,13 @@ void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 			UseImpact = Hit;
 		}
 
+		UShooterActorPool* Pool = UShooterActorPool::Get(this);
 		FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint);
-		AShooterImpactEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(ImpactTemplate, SpawnTransform);
+		AShooterImpactEffect* EffectActor = Pool ? Pool->BeginAcquire<AShooterImpactEffect>(ImpactTemplate, SpawnTransform) : NULL;
 		if (EffectActor)
 		{
 			EffectActor->SurfaceHit = UseImpact;
-			UGameplayStatics::FinishSpawningActor(EffectActor, SpawnTransform);
+			Pool->FinishAcquire(EffectActor, SpawnTransform);
 		}
 	}
 }
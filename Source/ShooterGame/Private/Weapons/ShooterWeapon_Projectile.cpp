@@ -71,15 +71,19 @@ bool AShooterWeapon_Projectile::ServerFireProjectile_Validate(FVector Origin, FV
 
 void AShooterWeapon_Projectile::ServerFireProjectile_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir)
 {
+	UShooterActorPool* Pool = UShooterActorPool::Get(this);
+	if (Pool == NULL)
+	{
+		return;
+	}
+
 	FTransform SpawnTM(ShootDir.Rotation(), Origin);
-	AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ProjectileConfig.ProjectileClass, SpawnTM));
+	AShooterProjectile* Projectile = Pool->BeginAcquire<AShooterProjectile>(ProjectileConfig.ProjectileClass, SpawnTM, this, GetInstigator());
 	if (Projectile)
 	{
-		Projectile->SetInstigator(GetInstigator());
-		Projectile->SetOwner(this);
 		Projectile->InitVelocity(ShootDir);
 
-		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+		Pool->FinishAcquire(Projectile, SpawnTM);
 	}
 }
 
@@ -11,4 +11,14 @@ class UBTTask_FindPickup : public UBTTask_BlackboardBase
 	GENERATED_UCLASS_BODY()
 		
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+protected:
+
+	/** pick the pickup with the cheapest navmesh path instead of the closest one in a straight line */
+	UPROPERTY(EditAnywhere, Category = Pickup)
+	uint32 bUsePathCost : 1;
+
+	/** how many of the closest pickups get their path cost computed */
+	UPROPERTY(EditAnywhere, Category = Pickup, meta = (EditCondition = "bUsePathCost", ClampMin = "1"))
+	int32 MaxPathCostCandidates;
 };
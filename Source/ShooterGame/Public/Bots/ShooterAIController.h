@@ -50,7 +50,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Behavior)
 	bool FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEnemy);
 		
-	bool HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const;
+	/** bTraceNowIfUnknown traces synchronously when the enemy was never traced before, instead of reporting no LOS until the async trace is back */
+	bool HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy, const bool bTraceNowIfUnknown = false) const;
 
 	// Begin AAIController interface
 	/** Update direction AI is looking based on FocalPoint */
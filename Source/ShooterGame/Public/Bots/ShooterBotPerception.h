@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterBotPerception.generated.h"
+
+/** outcome of a bot's weapon LOS trace, callers decide what counts as LOS from it */
+struct FShooterLOSResult
+{
+	/** the trace was blocked by something */
+	bool bBlockingHit = false;
+
+	/** actor that blocked the trace, if any and still alive */
+	AActor* HitActor = nullptr;
+
+	/** squared distance from the eyes to the blocking hit */
+	float HitDistSq = 0.f;
+
+	/** squared distance from the eyes to the traced location */
+	float TargetDistSq = 0.f;
+};
+
+/**
+ * Line of sight service shared by the bots' behavior tree decorators and controllers.
+ *
+ * Requests for the same viewer and target are answered from a short lived cache. Requests that
+ * miss it are submitted as async traces, identical requests made in the same frame share a single
+ * trace, and all of them are run together by the engine's async trace batch. Results come back
+ * the next frame, until then the previous result for the pair (if any) is used. Callers that can't
+ * wait for a pair never traced before can ask for a synchronous trace instead.
+ */
+UCLASS()
+class UShooterBotPerception : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get the perception service of the world of the given object, can be null */
+	static UShooterBotPerception* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Get the result of a weapon trace from the viewer's eyes to the target.
+	 *
+	 * @param Viewer			Pawn looking, ignored by the trace.
+	 * @param Target			Actor looked at, or null when looking at a location.
+	 * @param TargetLocation	Location looked at, only used when Target is null.
+	 * @param OutResult			Latest known result for the pair.
+	 * @param bTraceNowIfUnknown	If the pair has no result yet, trace synchronously instead of waiting for the async trace.
+	 * @returns false if no trace for the pair has completed yet
+	 */
+	bool GetLOSResult(APawn* Viewer, AActor* Target, const FVector& TargetLocation, FShooterLOSResult& OutResult, bool bTraceNowIfUnknown = false);
+
+	virtual void Deinitialize() override;
+
+private:
+
+	struct FLOSKey
+	{
+		TWeakObjectPtr<APawn> Viewer;
+		TWeakObjectPtr<AActor> Target;
+
+		/** quantized target location, only used when there is no target actor */
+		FIntVector TargetCell;
+
+		bool operator==(const FLOSKey& Other) const
+		{
+			return Viewer == Other.Viewer && Target == Other.Target && TargetCell == Other.TargetCell;
+		}
+
+		friend uint32 GetTypeHash(const FLOSKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Viewer), GetTypeHash(Key.Target)), GetTypeHash(Key.TargetCell));
+		}
+	};
+
+	struct FLOSEntry
+	{
+		/** world time the last result came in */
+		float ResultTime = -MAX_FLT;
+
+		/** world time someone last asked for this pair */
+		float RequestTime = 0.f;
+
+		/** world time the trace in flight was submitted */
+		float SubmitTime = 0.f;
+
+		/** id of the trace in flight, 0 when there is none */
+		uint32 PendingTraceId = 0;
+
+		bool bHasResult = false;
+		bool bBlockingHit = false;
+		TWeakObjectPtr<AActor> HitActor;
+		float HitDistSq = 0.f;
+		float TargetDistSq = 0.f;
+	};
+
+	/** async trace callback */
+	void OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** store the outcome of a trace from Start to End in the entry */
+	void StoreResult(FLOSEntry& Entry, const FHitResult* Hit, const FVector& Start, const FVector& End);
+
+	/** drop entries nobody asked for in a while, at most once per frame */
+	void ConditionalPrune();
+
+	/** cached results per viewer and target */
+	TMap<FLOSKey, FLOSEntry> Cache;
+
+	/** keys of the traces in flight */
+	TMap<uint32, FLOSKey> PendingTraces;
+
+	FTraceDelegate TraceDelegate;
+
+	/** id of the last trace submitted */
+	uint32 LastTraceId = 0;
+
+	/** GFrameCounter of the last prune */
+	uint64 LastPruneFrame = 0;
+};
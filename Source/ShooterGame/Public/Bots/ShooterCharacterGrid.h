@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterCharacterGrid.generated.h"
+
+class AShooterCharacter;
+
+/**
+ * Uniform 2D grid of the characters in the world, shared by all bots for target acquisition and by
+ * the game mode for rating spawnpoints.
+ *
+ * The grid is rebuilt at most once per frame, lazily by the first query of that frame, so the cost of
+ * walking the characters is paid once instead of once per bot. Queries walk rings of cells outwards
+ * from the querier and hand out candidates nearest-first, which lets callers stop at the first one
+ * that passes their test (e.g. a LOS trace) instead of testing every character in the world.
+ */
+UCLASS()
+class UShooterCharacterGrid : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get the grid of the world of the given object, can be null */
+	static UShooterCharacterGrid* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Walk the live enemies of the controller nearest-first until Predicate accepts one.
+	 *
+	 * @param Querier		Controller looking for an enemy, its own pawn is never a candidate.
+	 * @param Origin		Location distances are measured from.
+	 * @param Predicate		Called for each candidate in increasing distance order, return true to stop.
+	 * @returns the first candidate accepted by Predicate, or null
+	 */
+	AShooterCharacter* FindNearestEnemy(AController* Querier, const FVector& Origin, TFunctionRef<bool(AShooterCharacter*)> Predicate);
+
+	/** nearest live enemy of the controller, or null */
+	AShooterCharacter* FindNearestEnemy(AController* Querier, const FVector& Origin);
+
+	/** add a character spawned after this frame's rebuild, so queries later in the frame see it */
+	void AddCharacter(AShooterCharacter* Character);
+
+	/** call Visitor for every character, dead or alive, whose location is within Radius of Origin in 2D */
+	void ForEachCharacterInRadius(const FVector& Origin, float Radius, TFunctionRef<void(AShooterCharacter*)> Visitor);
+
+private:
+
+	struct FEntry
+	{
+		AShooterCharacter* Character;
+		FVector Location;
+		int32 TeamNum;
+	};
+
+	/** rebuild the cells from the characters in the world if that didn't happen yet this frame */
+	void ConditionalRebuild();
+
+	/** add a character to the entries and cells */
+	void AddEntry(AShooterCharacter* Character);
+
+	/** cell coordinates of a world location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** characters, cells index into this */
+	TArray<FEntry> Entries;
+
+	/** entries per occupied cell */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** bounds of the occupied cells, rings past these are empty */
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+
+	/** cell size the cells were built with */
+	float CellSize = 0.f;
+
+	/** true when the game has teams, same team entries are skipped without asking the game mode */
+	bool bTeamGame = false;
+
+	/** GFrameCounter of the last rebuild */
+	uint64 LastRebuildFrame = MAX_uint64;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ShooterTypes.h"
+#include "ShooterActorPool.h"
 #include "ShooterExplosionEffect.generated.h"
 
 //
@@ -10,7 +11,7 @@
 // Each explosion type should be defined as separate blueprint
 //
 UCLASS(Abstract, Blueprintable)
-class AShooterExplosionEffect : public AActor
+class AShooterExplosionEffect : public AActor, public IShooterPooledActor
 {
 	GENERATED_UCLASS_BODY()
 
@@ -43,12 +44,14 @@ public:
 	/** update fading light */
 	virtual void Tick(float DeltaSeconds) override;
 
-protected:
 	/** spawn explosion */
-	virtual void BeginPlay() override;
+	virtual void OnAcquiredFromPool() override;
 
 private:
 
+	/** time the explosion was spawned, the light fades out from there */
+	float ExplosionStartTime;
+
 	/** Point light component name */
 	FName ExplosionLightComponentName;
 
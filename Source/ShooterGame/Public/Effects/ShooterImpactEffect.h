@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ShooterTypes.h"
+#include "ShooterActorPool.h"
 #include "ShooterImpactEffect.generated.h"
 
 //
@@ -10,7 +11,7 @@
 // Each impact type should be defined as separate blueprint
 //
 UCLASS(Abstract, Blueprintable)
-class AShooterImpactEffect : public AActor
+class AShooterImpactEffect : public AActor, public IShooterPooledActor
 {
 	GENERATED_UCLASS_BODY()
 
@@ -95,10 +96,13 @@ class AShooterImpactEffect : public AActor
 	FHitResult SurfaceHit;
 
 	/** spawn effect */
-	virtual void PostInitializeComponents() override;
+	virtual void OnAcquiredFromPool() override;
 
 protected:
 
+	/** everything spawned is fire and forget, go back to the pool */
+	void ReleaseToPool();
+
 	/** get FX for material type */
 	UParticleSystem* GetImpactFX(TEnumAsByte<EPhysicalSurface> SurfaceType) const;
 
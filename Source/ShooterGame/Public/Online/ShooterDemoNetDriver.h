@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DemoNetDriver.h"
+#include "ShooterDemoNetDriver.generated.h"
+
+/**
+ * Demo net driver that tracks the game thread cost of recording and how much recorded data waits for the replay streamer
+ * to flush it. Files are compressed and written off the game thread by FShooterReplayStreamer, which also caps that data.
+ * Client and listen server recordings take checkpoints more often so kill seeks in the demo HUD replay fewer frames.
+ */
+UCLASS(transient, config=Engine)
+class UShooterDemoNetDriver : public UDemoNetDriver
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual bool InitListen(FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error) override;
+	virtual void TickFlush(float DeltaSeconds) override;
+	virtual void Shutdown() override;
+
+	/** Checkpoint interval for recordings not made by a dedicated server, which keep the engine default */
+	UPROPERTY(config)
+	float LocalCheckpointUploadDelayInSeconds;
+
+private:
+
+	/** demo.CheckpointUploadDelayInSeconds is process wide, the value it had before this recording, restored on shutdown */
+	TOptional<float> PreviousCheckpointUploadDelay;
+};
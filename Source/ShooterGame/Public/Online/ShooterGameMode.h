@@ -28,6 +28,9 @@ class AShooterGameMode : public AGameMode
 	/** Initialize the game. This is called before actors' PreInitializeComponents. */
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
+	/** stops listening for streamed levels */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Accept or reject a player attempting to join the server.  Fails login if you set the ErrorMessage to a non-empty string. */
 	virtual void PreLogin(const FString& Options, const FString& Address, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage) override;
 
@@ -67,6 +70,9 @@ class AShooterGameMode : public AGameMode
 	/** starts new match */
 	virtual void HandleMatchHasStarted() override;
 
+	/** records the new state in the replay */
+	virtual void OnMatchStateSet() override;
+
 	/** new player joins */
 	virtual void HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer) override;
 
@@ -140,6 +146,34 @@ protected:
 	/** check if player should use spawnpoint */
 	virtual bool IsSpawnpointPreferred(APlayerStart* SpawnPoint, AController* Player) const;
 
+	/** how dangerous the spawnpoint is for the player because of nearby enemies, lower is better */
+	virtual float RateSpawnpointDanger(APlayerStart* SpawnPoint, AController* Player, bool bCheckSightLines) const;
+
+	/** collect the player starts of the level */
+	void CachePlayerStarts();
+
+	/** a level was streamed in or out, its player starts are picked up before the next spawn */
+	void OnLevelAddedOrRemoved(ULevel* Level, UWorld* World);
+
+	/** player starts of the loaded levels, collected in InitGame and again after levels stream in or out */
+	UPROPERTY(Transient)
+	TArray<APlayerStart*> CachedPlayerStarts;
+
+	/** streamed levels changed since CachedPlayerStarts was collected */
+	bool bPlayerStartsDirty;
+
+	/** enemies closer than this to a spawnpoint make it less likely to be picked */
+	UPROPERTY(config)
+	float SpawnEnemyAvoidRadius;
+
+	/** how many of the safest spawnpoints get their sight lines from enemies checked */
+	UPROPERTY(config)
+	int32 SpawnSightCheckCandidates;
+
+	/** record a replay of every match when running as a dedicated server */
+	UPROPERTY(config)
+	bool bRecordDedicatedServerReplays;
+
 	/** Returns game session class to use */
 	virtual TSubclassOf<AGameSession> GetGameSessionClass() const override;	
 
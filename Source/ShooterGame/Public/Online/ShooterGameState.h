@@ -8,6 +8,9 @@
 /** ranked PlayerState map, created from the GameState */
 typedef TMap<int32, TWeakObjectPtr<AShooterPlayerState> > RankedPlayerMap; 
 
+/** players of a team, best score first */
+typedef TArray<TWeakObjectPtr<AShooterPlayerState> > RankedPlayerList;
+
 UCLASS()
 class AShooterGameState : public AGameState
 {
@@ -31,14 +34,28 @@ public:
 	UPROPERTY(Transient, Replicated)
 	bool bTimerPaused;
 
-	/** gets ranked PlayerState map for specific team */
-	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
+	/** gets the players of a team, best score first, rebuilt only after scores, teams or players changed */
+	const RankedPlayerList& GetRankedPlayers(int32 TeamIndex) const;
+
+	/** gets the rank of a player in its team, 0 for the best score, INDEX_NONE if it isn't ranked */
+	int32 GetPlayerRank(const AShooterPlayerState* PlayerState) const;
+
+	/** changes every time the ranking may have changed, compare with a previous value to skip unneeded updates */
+	uint32 GetRankingVersion() const { return RankingVersion; }
+
+	/** the ranking needs to be rebuilt before it's read next */
+	void InvalidateRanking();
 
 	void RequestFinishAndExitToMainMenu();
 
 	virtual void HandleMatchHasStarted() override;
 	virtual void HandleMatchHasEnded() override;
 
+	// Begin AGameStateBase interface
+	virtual void AddPlayerState(APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
+	// End AGameStateBase interface
+
 protected:
 	UPROPERTY(config)
 	FString ActivityId;
@@ -47,4 +64,19 @@ protected:
 	bool bEnableGameFeedback;
 
 	FShooterOnlineGameMatches GameMatches;
+
+	/** fill the actor pool with what the weapons of this match will spawn */
+	void PrewarmActorPool();
+
+	/** sort the players into RankedPlayers if the ranking was invalidated */
+	void ConditionalRebuildRanking() const;
+
+	/** ranked players per team, built on demand */
+	mutable TArray<RankedPlayerList> RankedPlayers;
+
+	/** true when RankedPlayers is out of date */
+	mutable bool bRankingDirty = true;
+
+	/** incremented by InvalidateRanking */
+	uint32 RankingVersion = 0;
 };
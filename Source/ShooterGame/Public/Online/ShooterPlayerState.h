@@ -24,6 +24,9 @@ class AShooterPlayerState : public APlayerState
 	virtual void RegisterPlayerWithSession(bool bWasFromInvite) override;
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** update the ranking of the game state with the replicated score */
+	virtual void OnRep_Score() override;
+
 	// End APlayerState interface
 
 	/**
@@ -39,6 +42,12 @@ class AShooterPlayerState : public APlayerState
 	/** player died */
 	void ScoreDeath(AShooterPlayerState* KilledBy, int32 Points);
 
+	/** player damaged someone else */
+	void ScoreHit(float Damage);
+
+	/** player was damaged */
+	void ScoreDamageTaken(float Damage);
+
 	/** get current team */
 	int32 GetTeamNum() const;
 
@@ -48,6 +57,15 @@ class AShooterPlayerState : public APlayerState
 	/** get number of deaths */
 	int32 GetDeaths() const;
 
+	/** get number of hits on someone else */
+	int32 GetHits() const;
+
+	/** get damage dealt to someone else */
+	float GetDamageDealt() const;
+
+	/** get damage taken */
+	float GetDamageTaken() const;
+
 	/** get number of bullets fired this match */
 	int32 GetNumBulletsFired() const;
 
@@ -91,6 +109,9 @@ protected:
 	/** Set the mesh colors based on the current teamnum variable */
 	void UpdateTeamColors();
 
+	/** tell the game state its ranking is out of date, after a score or team change */
+	void InvalidateRanking();
+
 	/** team number */
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_TeamColor)
 	int32 TeamNumber;
@@ -103,12 +124,24 @@ protected:
 	UPROPERTY(Transient, Replicated)
 	int32 NumDeaths;
 
-	/** number of bullets fired this match */
-	UPROPERTY()
+	/** number of hits on someone else, counted on the server for every hit and only replicated to the owner and replays */
+	UPROPERTY(Transient, Replicated)
+	int32 NumHits;
+
+	/** damage dealt to someone else, see NumHits */
+	UPROPERTY(Transient, Replicated)
+	float DamageDealt;
+
+	/** damage taken, see NumHits */
+	UPROPERTY(Transient, Replicated)
+	float DamageTaken;
+
+	/** number of bullets fired this match, see NumHits */
+	UPROPERTY(Transient, Replicated)
 	int32 NumBulletsFired;
 
-	/** number of rockets fired this match */
-	UPROPERTY()
+	/** number of rockets fired this match, see NumHits */
+	UPROPERTY(Transient, Replicated)
 	int32 NumRocketsFired;
 
 	/** whether the user quit the match */
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterReplayAnalyzer.generated.h"
+
+/**
+ * Gathers per-player statistics while a replay plays back headless, started with
+ *		-nullrhi -nosound -benchmark -fps=20 -AnalyzeReplay=<ReplayName> -AnalyzeOutput=<PathWithoutExtension>
+ *
+ * -benchmark makes every frame advance by a fixed step without waiting for real time, so playback runs as fast
+ * as the CPU allows. When the replay ends the statistics are written to <Output>.csv (one row per player) and
+ * <Output>_positions.csv (sampled positions), and the process exits.
+ * UShooterReplayAnalyzerCommandlet runs one such process per replay, several at a time.
+ */
+UCLASS()
+class UShooterReplayAnalyzer : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get the analyzer of the world of the given object, null unless this process analyzes a replay */
+	static UShooterReplayAnalyzer* Get(const UObject* WorldContextObject);
+
+	/** true if this process was started to analyze a replay */
+	static bool IsAnalyzing();
+
+	/** name of the replay to analyze, from the command line */
+	static FString GetReplayName();
+
+	// Begin USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	struct FPlayerStats
+	{
+		int32 TeamNum = INDEX_NONE;
+		int32 Shots = 0;
+		int32 Hits = 0;
+		int32 Kills = 0;
+		int32 Deaths = 0;
+		float DamageDealt = 0.f;
+		float DamageTaken = 0.f;
+		float Distance = 0.f;
+		FVector LastLocation = FVector::ZeroVector;
+
+		/** sample LastLocation is from, distance only adds up between consecutive samples so respawns don't count */
+		int32 LastSample = INDEX_NONE;
+	};
+
+	/** stats of the player controlling the pawn, null if it has no player state */
+	FPlayerStats* FindStats(const APawn* Pawn);
+
+	/** stats of the player, null for spectators */
+	FPlayerStats* FindStats(const AShooterPlayerState* PlayerState);
+
+	/** copy the shot, hit, kill and damage counters the server keeps on the player states, nothing is missed between frames */
+	void ReadPlayerCounters();
+
+	/** add a row for every live character to the positions and update the travelled distances */
+	void SamplePositions(float DemoTime);
+
+	/** write both files and exit */
+	void Finish();
+
+	/** stats per player name, names survive reconnects where player states don't */
+	TMap<FString, FPlayerStats> Players;
+
+	/** rows of the positions file */
+	FString PositionRows;
+
+	/** demo time of the last position sample */
+	float LastSampleTime = -MAX_flt;
+
+	/** number of position samples taken */
+	int32 NumSamples = 0;
+
+	/** files are written, nothing left to do */
+	bool bFinished = false;
+};
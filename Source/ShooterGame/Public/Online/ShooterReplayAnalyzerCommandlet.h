@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "ShooterReplayAnalyzerCommandlet.generated.h"
+
+/**
+ * Analyzes many replays in parallel, one headless game process per replay (see UShooterReplayAnalyzer).
+ * A replay plays in its own world with its own demo driver, so separate processes are what scales across cores.
+ *
+ *		UE4Editor-Cmd ShooterGame.uproject -run=ShooterReplayAnalyzer [-Replays=A+B] [-ReplayDir=Dir] [-OutputDir=Dir] [-Jobs=N]
+ *
+ * Without -Replays every replay in -ReplayDir (Saved/Demos by default) is analyzed.
+ * -Jobs defaults to the number of logical cores.
+ */
+UCLASS()
+class UShooterReplayAnalyzerCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
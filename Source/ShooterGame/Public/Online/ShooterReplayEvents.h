@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "NetworkReplayStreaming.h"
+
+class UDemoNetDriver;
+
+/**
+ * Events written into replays next to the checkpoints, so playback can find kills without scrubbing.
+ * The streamer keeps them in the replay's chunk index, enumerating them doesn't read any stream data.
+ */
+namespace ShooterReplayEvents
+{
+	/** killer and victim names */
+	extern const FString KillGroup;
+
+	/** new match state */
+	extern const FString MatchStateGroup;
+
+	/** player name and new score */
+	extern const FString ScoreGroup;
+
+	/** [server] add an event at the current time of the replay being recorded, if any */
+	void Record(UWorld* World, const FString& Group, const FString& Meta);
+}
+
+/** Kill times of the replay being played, sorted, for jumping between kills */
+class FShooterReplayEventIndex : public TSharedFromThis<FShooterReplayEventIndex>
+{
+public:
+
+	/** ask the streamer of the replay for its kills, the index is empty until they arrive */
+	void Build(UDemoNetDriver* DemoDriver);
+
+	/** time in seconds of the first kill after Time, negative if there is none */
+	float FindNextKillTime(float Time) const;
+
+	/** time in seconds of the last kill before Time, negative if there is none */
+	float FindPreviousKillTime(float Time) const;
+
+	/** times in seconds of all kills, sorted */
+	const TArray<float>& GetKillTimes() const { return KillTimes; }
+
+private:
+
+	void OnKillsEnumerated(const FEnumerateEventsResult& Result);
+
+	TArray<float> KillTimes;
+};
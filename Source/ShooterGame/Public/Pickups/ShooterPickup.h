@@ -16,10 +16,19 @@ class AShooterPickup : public AActor
 	/** check if pawn can use this pickup */
 	virtual bool CanBePickedUp(class AShooterCharacter* TestPawn) const;
 
+	/** weapon class this pickup is for, if any */
+	virtual TSubclassOf<class AShooterWeapon> GetWeaponType() const { return nullptr; }
+
+	/** is it ready for interactions? */
+	bool IsActive() const { return bIsActive; }
+
 protected:
 	/** initial setup */
 	virtual void BeginPlay() override;
 
+	/** unregister from the pickup registry */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	/** FX component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Effects)
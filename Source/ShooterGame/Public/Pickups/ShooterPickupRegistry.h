@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterPickupRegistry.generated.h"
+
+class AShooterPickup;
+
+/**
+ * [server] pickups of the level, bucketed by pickup class and weapon class, each bucket with its own uniform grid.
+ *
+ * Pickups register themselves on BeginPlay and keep their active state up to date when they are picked up or
+ * respawn, so queries only look at the buckets they ask for and skip picked up pickups without touching them.
+ */
+UCLASS()
+class UShooterPickupRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get the registry of the world of the given object, can be null */
+	static UShooterPickupRegistry* Get(const UObject* WorldContextObject);
+
+	/** add a pickup, its location is not expected to change */
+	void RegisterPickup(AShooterPickup* Pickup);
+
+	/** remove a pickup, e.g. when it is destroyed */
+	void UnregisterPickup(AShooterPickup* Pickup);
+
+	/** update whether the pickup can be picked up */
+	void SetPickupActive(AShooterPickup* Pickup, bool bActive);
+
+	/**
+	 * Find the closest active pickups of the given class, nearest-first.
+	 *
+	 * @param PickupClass	Class the pickups must be of.
+	 * @param WeaponClass	Class the weapon of the pickups must be of, null for any.
+	 * @param Origin		Location distances are measured from.
+	 * @param MaxResults	Stop after finding this many pickups.
+	 * @param Predicate		Extra test for each candidate, called in increasing distance order.
+	 * @param OutPickups	Pickups found, nearest first.
+	 */
+	void FindNearestPickups(UClass* PickupClass, UClass* WeaponClass, const FVector& Origin, int32 MaxResults, TFunctionRef<bool(AShooterPickup*)> Predicate, TArray<AShooterPickup*>& OutPickups) const;
+
+	virtual void Deinitialize() override;
+
+private:
+
+	struct FEntry
+	{
+		AShooterPickup* Pickup;
+		FVector Location;
+		bool bActive;
+	};
+
+	struct FBucket
+	{
+		UClass* PickupClass;
+		UClass* WeaponClass;
+
+		/** pickups of the bucket, unregistered ones are left as null entries */
+		TArray<FEntry> Entries;
+
+		/** entries per occupied cell */
+		TMap<FIntPoint, TArray<int32>> Cells;
+
+		/** bounds of the occupied cells */
+		FIntPoint MinCell = FIntPoint(MAX_int32, MAX_int32);
+		FIntPoint MaxCell = FIntPoint(MIN_int32, MIN_int32);
+	};
+
+	struct FCandidate
+	{
+		AShooterPickup* Pickup;
+		float DistSq;
+	};
+
+	/** add up to MaxResults candidates from the bucket, nearest first */
+	void GatherNearest(const FBucket& Bucket, const FVector& Origin, int32 MaxResults, TFunctionRef<bool(AShooterPickup*)> Predicate, TArray<FCandidate>& OutCandidates) const;
+
+	/** cell coordinates of a world location */
+	static FIntPoint GetCell(const FVector& Location);
+
+	TArray<FBucket> Buckets;
+
+	/** bucket and entry index of every registered pickup */
+	TMap<const AShooterPickup*, FIntPoint> PickupIndices;
+};
@@ -19,6 +19,9 @@ class AShooterPickup_Ammo : public AShooterPickup
 
 	bool IsForWeapon(UClass* WeaponClass);
 
+	/** get weapon class given ammo by this pickup */
+	virtual TSubclassOf<AShooterWeapon> GetWeaponType() const override { return WeaponType; }
+
 protected:
 
 	/** how much ammo does it give? */
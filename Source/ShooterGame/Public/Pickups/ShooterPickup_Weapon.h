@@ -22,6 +22,9 @@ class AShooterPickup_Weapon : public AShooterPickup
 
 	bool IsForWeapon(UClass* WeaponClass);
 
+	/** get weapon class given by this pickup */
+	virtual TSubclassOf<AShooterWeapon> GetWeaponType() const override { return WeaponType; }
+
 protected:
 
 	virtual void BeginPlay() override;
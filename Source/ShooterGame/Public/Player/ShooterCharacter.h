@@ -4,6 +4,7 @@
 
 #include "ShooterTypes.h"
 #include "Pickups/ShooterPickup_Weapon.h"
+#include "Player/ShooterRewindHistory.h"
 #include "ShooterCharacter.generated.h"
 
 class UShooterCharacterMovement;
@@ -11,6 +12,54 @@ class UShooterCharacterMovement;
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterCharacterEquipWeapon, AShooterCharacter*, AShooterWeapon* /* new */);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnShooterCharacterUnEquipWeapon, AShooterCharacter*, AShooterWeapon* /* old */);
 
+/** points tested when deciding if replication should be paused for a connection, never more than 8 */
+typedef TArray<FVector, TInlineAllocator<8>> FPauseReplicationCheckPoints;
+
+/**
+ * Movement of a character as seen by simulated proxies, sent through the replication graph's fast shared path:
+ * it is serialized once per frame and the same bits are sent to every connection that is interested in the character.
+ */
+USTRUCT()
+struct FShooterSharedRepMovement
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** location, rotation and velocity */
+	UPROPERTY(Transient)
+	FRepMovement RepMovement;
+
+	/** packed movement mode, the custom mode tells simulated proxies whether the character is wall running */
+	UPROPERTY(Transient)
+	uint8 RepMovementMode;
+
+	/** compressed aim pitch, see APawn::RemoteViewPitch */
+	UPROPERTY(Transient)
+	uint8 RemoteViewPitch;
+
+	/** server timestamp of the transform, only sent when the movement component uses it for smoothing */
+	UPROPERTY(Transient)
+	float RepTimeStamp;
+
+	FShooterSharedRepMovement();
+
+	/** fills in the current state of the character, returns false if it can't be sent right now */
+	bool FillForCharacter(ACharacter* Character);
+
+	bool Equals(const FShooterSharedRepMovement& Other) const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FShooterSharedRepMovement> : public TStructOpsTypeTraitsBase2<FShooterSharedRepMovement>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+	};
+};
+
 ////Enum for the direction of the wall the character want to wallrun
 //UENUM(BlueprintType)				
 //enum class EWallRunSide : uint8 {
@@ -253,6 +302,9 @@ class AShooterCharacter : public ACharacter
 	/** get weapon attach point */
 	FName GetWeaponAttachPoint() const;
 
+	/** get weapon classes spawned into the inventory on spawn */
+	const TArray<TSubclassOf<class AShooterWeapon> >& GetDefaultInventoryClasses() const { return DefaultInventoryClasses; }
+
 	/** get total number of inventory items */
 	int32 GetInventoryCount() const;
 
@@ -306,6 +358,21 @@ class AShooterCharacter : public ACharacter
 	/** Update the team color of all player meshes. */
 	void UpdateTeamColorsAllMIDs();
 
+	/** [client] throttle or resume the cosmetic work of the character, called by UShooterCharacterSignificance. Authority never throttles the animation */
+	void SetSignificance(EShooterSignificance::Type NewSignificance);
+
+	/** [client] how much cosmetic work the character currently gets */
+	EShooterSignificance::Type GetSignificance() const { return Significance; }
+
+	/** [server] recent collision poses, used to validate client side hits */
+	const FShooterRewindHistory& GetRewindHistory() const { return RewindHistory; }
+
+	/** true if characters and weapons spawned by the actor's world skip their cosmetic work: dedicated servers with p.ServerLeanCharacters */
+	static bool ShouldBeServerLean(const AActor* Actor);
+
+	/** [server] lean servers don't animate the 3rd person mesh on their own, evaluate its pose now for a shot that needs it */
+	void RefreshServerPose();
+
 private:
 
 	/** pawn mesh: 1st person view */
@@ -594,6 +661,19 @@ public:
 
 	/** Called on the actor right before replication occurs */
 	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+
+	/**
+	 * [server] called by the replication graph once per frame: sends the movement to simulated proxies through
+	 * FastSharedReplication if it changed since the last call.
+	 *
+	 * @returns false if the movement can't be sent through the fast shared path right now
+	 */
+	bool UpdateSharedReplication();
+
+	/** [client] movement of a simulated proxy, sent through the replication graph's fast shared path */
+	UFUNCTION(unreliable, NetMulticast)
+	void FastSharedReplication(const FShooterSharedRepMovement& SharedRepMovement);
+
 protected:
 	/** notification when killed, for both the server and client. */
 	virtual void OnDeath(float KillingDamage, struct FDamageEvent const& DamageEvent, class APawn* InstigatingPawn, class AActor* DamageCauser);
@@ -640,7 +720,81 @@ protected:
 	void ServerSetRunning(bool bNewRunning, bool bToggle);
 
 	/** Builds list of points to check for pausing replication for a connection*/
-	void BuildPauseReplicationCheckPoints(TArray<FVector>& RelevancyCheckPoints);
+	void BuildPauseReplicationCheckPoints(FPauseReplicationCheckPoints& RelevancyCheckPoints);
+
+private:
+
+	/** cached visibility of this pawn for a single viewer, used to pause replication */
+	struct FPauseReplicationVisibility
+	{
+		/** controller this result was computed for */
+		TWeakObjectPtr<APlayerController> Viewer;
+
+		/** engine frame the cached result was last handed out on */
+		uint64 LastQueryFrame = 0;
+
+		/** engine frame the pending trace batch was issued on */
+		uint64 PendingIssueFrame = 0;
+
+		/** world time the result was last refreshed */
+		float LastResultTime = 0.f;
+
+		/** traces of the pending batch that haven't reported back yet */
+		int32 PendingTraceCount = 0;
+
+		/** true if any trace of the pending batch reached the viewer */
+		bool bPendingAnyVisible = false;
+
+		/** true once at least one result has been computed */
+		bool bHasResult = false;
+
+		/** whether replication is paused for this viewer */
+		bool bPaused = false;
+	};
+
+	/** visibility results per viewer, keyed by the viewer's unique id */
+	TMap<uint32, FPauseReplicationVisibility> PauseReplicationVisibility;
+
+	/** delegate handed to the async visibility traces */
+	FTraceDelegate PauseReplicationTraceDelegate;
+
+	/** world time stale viewers were last pruned from PauseReplicationVisibility */
+	float LastPauseReplicationPruneTime;
+
+	/** [server] issues the visibility traces used to decide if replication is paused for a viewer */
+	void UpdatePauseReplicationVisibility(APlayerController* Viewer, FPauseReplicationVisibility& Visibility);
+
+	/** [server] async trace callback for the pause replication visibility test */
+	void OnPauseReplicationTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** [server] last movement sent through FastSharedReplication */
+	FShooterSharedRepMovement LastSharedReplication;
+
+	/** [server] recent capsule and hitbox poses, sampled every tick in network games */
+	FShooterRewindHistory RewindHistory;
+
+	/** [server] records the current pose in RewindHistory */
+	void RecordRewindHistory();
+
+	/** [server] how much bigger than the capsule the hitbox recorded on lean servers is, for limbs and weapons sticking out */
+	UPROPERTY(EditDefaultsOnly, Category = Mesh)
+	float LeanHitboxPadding;
+
+	/** [server] strip the cosmetic components, stop animating the 3rd person mesh and let the capsule take the hits */
+	void MakeServerLean();
+
+	/** [server] set by MakeServerLean */
+	bool bServerLean = false;
+
+	/** [server] GFrameCounter and world time of the last RefreshServerPose */
+	uint64 LastServerPoseFrame = 0;
+	float LastServerPoseTime = 0.f;
+
+	/** current significance, High until UShooterCharacterSignificance says otherwise */
+	EShooterSignificance::Type Significance = EShooterSignificance::High;
+
+	/** team colors changed while the character was Low significance, they are applied when it gets significant again */
+	bool bTeamColorsPending = false;
 
 protected:
 	/** Returns Mesh1P subobject **/
@@ -12,6 +12,38 @@
 
 #define CHARACTERNETWORKING_API DLLEXPORT
 
+// Move data sent with the packed ServerMove RPCs, carries the sprint and wall run state of the move in a few bits
+struct FShooterCharacterNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	enum EMoveFlags : uint8
+	{
+		MOVEFLAG_Sprint			= 0x01,
+		MOVEFLAG_WallRunKeys	= 0x02,
+		// The move started wall running, the side and direction are valid
+		MOVEFLAG_WallRunning	= 0x04,
+		MOVEFLAG_WallRunRight	= 0x08,
+	};
+
+	// Number of bits of MoveFlags that are serialized
+	static const uint32 NumMoveFlagBits = 4;
+
+	uint8 MoveFlags = 0;
+	// Yaw of the wall run direction compressed to a byte, only sent while wall running
+	uint8 WallRunDirectionYaw = 0;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+};
+
+struct FShooterCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FShooterCharacterNetworkMoveDataContainer();
+
+	FShooterCharacterNetworkMoveData ShooterMoveData[3];
+};
+
 UCLASS(BlueprintType)
 class CHARACTERNETWORKING_API UShooterCharacterMovement : public UCharacterMovementComponent
 {
@@ -39,6 +71,9 @@ private:
 	// The player's velocity while wall running
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "My Character Movement|Wall Running", Meta = (AllowPrivateAccess = "true"))
 		float WallRunSpeed = 625.0f;
+	// Length of the stretches of wall the cached wall is used for, the wall is traced again whenever the character enters the next one
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "My Character Movement|Wall Running", Meta = (AllowPrivateAccess = "true"))
+		float WallRunSurfaceRecheckDistance = 100.0f;
 #pragma endregion
 
 public:
@@ -48,6 +83,9 @@ public:
 
 #pragma region Overrides
 
+public:
+	UShooterCharacterMovement(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
@@ -70,6 +108,14 @@ public:
 	virtual void ProcessLanded(const FHitResult& Hit, float remainingTime, int32 Iterations) override;
 	//Function to handle the client prediction
 	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	//Count the packed ServerMove RPCs received
+	virtual void ServerMove_HandleMoveData(const FCharacterNetworkMoveDataContainer& MoveDataContainer) override;
+	//Apply the sprint and wall run state of a move received from the client before performing it, only accepted moves get here
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+	//Remember how far off the client was for the correction telemetry
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+	//Count the corrections sent to the client
+	virtual void SendClientAdjustment() override;
 
 #pragma endregion
 
@@ -79,6 +125,21 @@ private:
 	uint8 WallRunKeysDown : 1;
 #pragma endregion
 
+#pragma region Network
+public:
+	// Number of ServerMove RPCs received from the owning client
+	uint32 GetNumServerMovesReceived() const { return NumServerMovesReceived; }
+	// Number of position corrections sent to the owning client
+	uint32 GetNumClientCorrections() const { return NumClientCorrections; }
+
+private:
+	FShooterCharacterNetworkMoveDataContainer ShooterMoveDataContainer;
+	uint32 NumServerMovesReceived = 0;
+	uint32 NumClientCorrections = 0;
+	// Distance between the client and server locations of the last move checked
+	float LastClientError = 0.0f;
+#pragma endregion
+
 #pragma region Private Variables
 	// True if the sprint key is down
 	bool SprintKeyDown = false;
@@ -87,6 +148,15 @@ private:
 	FVector WallRunDirection;
 	// The side of the wall the player is running on.
 	EWallRunSide WallRunSide;
+	// The wall found by the last wall trace, kept while wall running so IsNextToWall doesn't trace every sub-step
+	TWeakObjectPtr<UPrimitiveComponent> WallRunSurface;
+	// Transform of the wall when it was traced, the cache is dropped if the wall moves
+	FTransform WallRunSurfaceTransform;
+	// Impact point and normal of the last wall trace
+	FVector WallRunSurfacePoint;
+	FVector WallRunSurfaceNormal;
+	// Stretch of the wall the character was in when the wall was last traced, see GetWallRunRecheckIndex
+	int32 WallRunSurfaceRecheckIndex;
 #pragma endregion
 
 #pragma region WallRun
@@ -101,6 +171,8 @@ public:
 	bool AreRequiredWallRunKeysDown() const;
 	// Returns true if the player is next to a wall that can be wall ran
 	bool IsNextToWall(float vertical_tolerance = 0.0f);
+	// Forget the cached wall, the next IsNextToWall call will trace
+	void ClearWallRunSurface();
 	// Finds the wall run direction and side based on the specified surface normal
 	void FindWallRunDirectionAndSide(const FVector& surface_normal, FVector& direction, EWallRunSide& side) const;
 	// Helper function that returns true if the specified surface normal can be wall ran on
@@ -109,6 +181,10 @@ public:
 	bool IsCustomMovementMode(uint8 custom_movement_mode) const;
 
 private:
+	// Returns true if the cached wall is still next to the character, without tracing. Only walls with a single box for collision are cached
+	bool IsNextToCachedWall(float vertical_tolerance) const;
+	// Index of the stretch of wall of length WallRunSurfaceRecheckDistance the location is in, along the wall run direction
+	int32 GetWallRunRecheckIndex(const FVector& location) const;
 	// Called when the owning actor hits something (to begin the wall run)
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
@@ -144,10 +220,17 @@ public:
 	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, class FNetworkPredictionData_Client_Character& ClientData) override;
 	// Sets variables on character movement component before making a predictive correction.
 	virtual void PrepMoveFor(class ACharacter* Character) override;
+	// Moves that change the sprint or wall run keys are resent with the next move if they are lost.
+	virtual bool IsImportantMove(const FSavedMovePtr& LastAckedMove) const override;
 
 private:
+	friend struct FShooterCharacterNetworkMoveData;
+
 	uint8 SavedWantsToSprint : 1;
 	uint8 SavedWallRunKeysDown : 1;
+	uint8 SavedWallRunning : 1;
+	EWallRunSide SavedWallRunSide;
+	FVector SavedWallRunDirection;
 };
 
 /** Custom movement modes for Characters. */
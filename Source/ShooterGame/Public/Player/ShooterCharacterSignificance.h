@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterCharacterSignificance.generated.h"
+
+class AShooterCharacter;
+
+/**
+ * [client] ranks the characters of the world by how much their cosmetic work (sounds, animation, team colors) is
+ * worth to the local viewers, and tells each character when its significance changes.
+ *
+ * Characters viewed by or close to a local player are High, up to p.SignificanceMaxHigh of them nearest-first.
+ * Other characters rendered recently are Medium, the others Low. The ranking is refreshed
+ * every p.SignificanceUpdateInterval seconds. Not created on dedicated servers, where characters skip their cosmetic
+ * work altogether.
+ */
+UCLASS()
+class UShooterCharacterSignificance : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Begin USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	struct FCandidate
+	{
+		AShooterCharacter* Character;
+		float DistSq;
+		bool bRendered;
+	};
+
+	/** rank every character and update its significance */
+	void UpdateSignificance();
+
+	/** characters of the last update, kept to reuse the allocation */
+	TArray<FCandidate> Candidates;
+
+	/** world time of the last update */
+	float LastUpdateTime = -MAX_flt;
+};
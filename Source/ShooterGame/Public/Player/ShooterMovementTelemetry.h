@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ShooterCharacterMovement.h"
+#include "ShooterMovementTelemetry.generated.h"
+
+class UNetConnection;
+
+/**
+ * [server] movement prediction telemetry per client connection: ServerMove RPC rate, corrections sent with their
+ * error and the movement mode the server was in, and round trip time.
+ *
+ * UShooterCharacterMovement reports every ServerMove RPC and correction. Every p.MovementTelemetryInterval seconds
+ * the rates of the interval are computed, and on dedicated servers a row per connection is appended to
+ * Saved/Logs/MovementTelemetry-<time>.csv. ShooterMovementTelemetry.Stats prints the current values.
+ * Connections get their record when they send their first move, recording doesn't allocate after that.
+ */
+UCLASS()
+class UShooterMovementTelemetry : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get the telemetry of the world of the given object, can be null */
+	static UShooterMovementTelemetry* Get(const UObject* WorldContextObject);
+
+	/** a ServerMove RPC was received from the connection */
+	void NotifyServerMove(UNetConnection* Connection);
+
+	/**
+	 * A correction is being sent to the connection.
+	 *
+	 * @param Connection			Connection of the corrected client.
+	 * @param Error					Distance between the client and server locations.
+	 * @param MovementMode			Movement mode of the server at the time of the correction.
+	 * @param CustomMovementMode	Custom movement mode of the server, if MovementMode is MOVE_Custom.
+	 */
+	void NotifyCorrection(UNetConnection* Connection, float Error, uint8 MovementMode, uint8 CustomMovementMode);
+
+	/** print the telemetry of every connection to the log */
+	void DumpStats() const;
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// End FTickableGameObject interface
+
+private:
+
+	/** walking, falling, etc. then one per custom movement mode */
+	static const int32 NumModeBuckets = MOVE_Custom + CMOVE_MAX;
+
+	struct FIntervalStats
+	{
+		uint32 ServerMoves = 0;
+		uint32 Corrections = 0;
+		uint32 CorrectionsByMode[NumModeBuckets] = {};
+		float ErrorSum = 0.f;
+		float MaxError = 0.f;
+
+		void Add(const FIntervalStats& Other);
+	};
+
+	struct FConnectionStats
+	{
+		TWeakObjectPtr<UNetConnection> Connection;
+
+		/** player name when the record was created */
+		FString Name;
+
+		/** since the record was created */
+		FIntervalStats Total;
+
+		/** since the start of the current interval */
+		FIntervalStats Current;
+
+		/** rates of the last complete interval */
+		float ServerMoveRate = 0.f;
+		float CorrectionRate = 0.f;
+
+		/** round trip time in ms at the end of the last interval */
+		float RoundTripTime = 0.f;
+	};
+
+	/** record of the connection, created the first time it is seen */
+	FConnectionStats* FindOrAddStats(UNetConnection* Connection);
+
+	/** compute the rates of the interval that just ended and start the next one */
+	void EndInterval(float IntervalLength);
+
+	/** append a row per connection to the csv, opening it the first time */
+	void WriteCsvRows();
+
+	/** bucket of CorrectionsByMode for a movement mode */
+	static int32 GetModeBucket(uint8 MovementMode, uint8 CustomMovementMode);
+
+	/** name of a bucket of CorrectionsByMode */
+	static const TCHAR* GetModeBucketName(int32 Bucket);
+
+	/** keyed by connection pointer, the weak pointer in the record catches addresses reused by a new connection */
+	TMap<const UNetConnection*, FConnectionStats> Connections;
+
+	/** real time the current interval started */
+	double IntervalStartTime = 0.0;
+
+	/** csv on dedicated servers, opened on the first interval */
+	TUniquePtr<FArchive> CsvWriter;
+
+	/** the csv couldn't be opened, don't try again */
+	bool bCsvFailed = false;
+};
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * [server] fixed size ring of recent collision poses of a character, used to validate client hits
+ * against where the target was when the client fired.
+ *
+ * Every field lives in its own array so a rewind only walks the timestamps until it finds its
+ * bracketing samples and then reads just those two entries of the pose arrays.
+ */
+struct FShooterRewindHistory
+{
+	/** number of samples kept, enough for half a second at 120Hz */
+	static const int32 MaxSamples = 64;
+
+	FShooterRewindHistory();
+
+	/** record the pose for the given world time, samples must be recorded in increasing time order */
+	void Record(float Time, const FVector& CapsuleLocation, const FBoxSphereBounds& HitboxBounds);
+
+	/**
+	 * Find the pose at the given world time, interpolating between the two closest samples.
+	 * Times older than the oldest sample return false, times newer than the latest sample use the latest sample.
+	 *
+	 * @param Time				World time to rewind to.
+	 * @param OutCapsuleLocation	Capsule center at that time.
+	 * @param OutHitbox			Hitbox (mesh bounds) at that time.
+	 * @returns true if the history covers the requested time
+	 */
+	bool GetPoseAtTime(float Time, FVector& OutCapsuleLocation, FBox& OutHitbox) const;
+
+private:
+
+	/** ring index of the physical slot for the Nth oldest sample */
+	FORCEINLINE int32 GetSlot(int32 Index) const { return (Head + MaxSamples - NumSamples + Index) % MaxSamples; }
+
+	float Times[MaxSamples];
+	FVector CapsuleLocations[MaxSamples];
+	FVector HitboxOrigins[MaxSamples];
+	FVector HitboxExtents[MaxSamples];
+
+	/** slot the next sample will be written to */
+	int32 Head;
+
+	/** number of valid samples */
+	int32 NumSamples;
+};
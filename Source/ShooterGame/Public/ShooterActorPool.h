@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterActorPool.generated.h"
+
+UINTERFACE()
+class UShooterPooledActor : public UInterface
+{
+	GENERATED_UINTERFACE_BODY()
+};
+
+/** actors handed out by UShooterActorPool, they start their effects here instead of in BeginPlay */
+class IShooterPooledActor
+{
+	GENERATED_IINTERFACE_BODY()
+
+	/** actor was taken out of the pool (or just spawned for it) and set up by the caller, start it as if it was just spawned */
+	virtual void OnAcquiredFromPool() {}
+
+	/** actor was deactivated and put back in the pool */
+	virtual void OnReleasedToPool() {}
+};
+
+/** inactive actors of a single class */
+USTRUCT()
+struct FShooterPooledActorList
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TArray<AActor*> Actors;
+
+	/** acquisitions served from the pool */
+	int32 NumHits = 0;
+
+	/** acquisitions that had to spawn a new actor */
+	int32 NumMisses = 0;
+};
+
+/**
+ * Recycles short lived actors (projectiles, impact and explosion effects) instead of spawning and destroying them.
+ *
+ * Released actors are hidden, stop ticking and colliding, and replicated ones go dormant so their channel
+ * is kept around rather than closed and reopened on the next use.
+ */
+UCLASS()
+class UShooterActorPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** get the pool of the world of the given object, can be null */
+	static UShooterActorPool* Get(const UObject* WorldContextObject);
+
+	/** release the actor to its world's pool, or destroy it if there is none */
+	static void ReleaseOrDestroy(AActor* Actor);
+
+	/**
+	 * Take an inactive actor of the class out of the pool, or begin spawning a new one.
+	 * The caller sets it up and then calls FinishAcquire, the same way as deferred spawning.
+	 */
+	AActor* BeginAcquire(TSubclassOf<AActor> ActorClass, const FTransform& Transform, AActor* Owner = nullptr, APawn* Instigator = nullptr);
+
+	template<class T>
+	T* BeginAcquire(TSubclassOf<AActor> ActorClass, const FTransform& Transform, AActor* Owner = nullptr, APawn* Instigator = nullptr)
+	{
+		return Cast<T>(BeginAcquire(ActorClass, Transform, Owner, Instigator));
+	}
+
+	/** activate an actor returned by BeginAcquire */
+	void FinishAcquire(AActor* Actor, const FTransform& Transform);
+
+	/** deactivate the actor and keep it for reuse */
+	void Release(AActor* Actor);
+
+	/** spawn inactive actors of the class until the pool holds Count of them */
+	void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/** log hits, misses and pool size per class */
+	void DumpStats() const;
+
+	virtual void Deinitialize() override;
+
+private:
+
+	/** deactivate without touching the stats or pool lists */
+	void Deactivate(AActor* Actor);
+
+	/** inactive actors per class */
+	UPROPERTY()
+	TMap<UClass*, FShooterPooledActorList> Pools;
+};
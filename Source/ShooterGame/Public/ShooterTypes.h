@@ -59,6 +59,20 @@ namespace EShooterPhysMaterialType
 	};
 }
 
+/** how much cosmetic work a character is worth to the local viewers, see UShooterCharacterSignificance */
+namespace EShooterSignificance
+{
+	enum Type
+	{
+		/** far from or out of sight of every local viewer: no sounds, slow animation, deferred team colors */
+		Low,
+		/** in sight but not close: animation is throttled */
+		Medium,
+		/** viewed or close: everything is updated every frame */
+		High,
+	};
+}
+
 namespace EShooterDialogType
 {
 	enum Type
@@ -22,13 +22,26 @@ class USoundNodeLocalPlayer : public USoundNode
 #endif
 	// End USoundNode interface.
 
-	static TMap<uint32, bool>& GetLocallyControlledActorCache()
-	{
-		check(IsInAudioThread());
-		return LocallyControlledActorCache;
-	}
+	/** [game thread] set whether the actor with the given unique ID is locally controlled, cheap to call every tick */
+	static void SetLocallyControlled(uint32 UniqueID, bool bLocallyControlled);
+
+	/** [game thread] forget an actor that is being destroyed */
+	static void RemoveActor(uint32 UniqueID);
 
 private:
 
-	static TMap<uint32, bool> LocallyControlledActorCache;
+	/** flat set of the unique IDs of locally controlled actors, only a handful so it never allocates */
+	typedef TArray<uint32, TInlineAllocator<16>> FLocallyControlledSet;
+
+	/** [game thread] hand the set to the audio thread at the end of a frame it changed in */
+	static void PublishLocallyControlledActors();
+
+	/** game thread copy, updated by the actors as they tick */
+	static FLocallyControlledSet PendingLocallyControlledActors;
+
+	/** audio thread copy, the snapshot of the last frame the game thread set changed in */
+	static FLocallyControlledSet LocallyControlledActors;
+
+	/** true if the game thread set changed since it was last published */
+	static bool bPendingDirty;
 };
@@ -21,6 +21,21 @@ struct FHitData
 	}
 };
 
+/** text drawn by the HUD along with its measured size, see AShooterHUD::GetHUDText */
+struct FShooterHUDText
+{
+	/** text to put in the canvas item */
+	FText Text;
+
+	/** size of the text at scale 1, multiply by the item scale */
+	FVector2D Size;
+
+	FShooterHUDText()
+		: Size(FVector2D::ZeroVector)
+	{
+	}
+};
+
 struct FDeathMessage
 {
 	/** Name of player scoring kill. */
@@ -29,6 +44,12 @@ struct FDeathMessage
 	/** Name of killed player. */
 	FString VictimDesc;
 
+	/** Killer name, measured when the message is added. */
+	FShooterHUDText KillerText;
+
+	/** Victim name, measured when the message is added. */
+	FShooterHUDText VictimText;
+
 	/** Killer is local player. */
 	uint8 bKillerIsOwner : 1;
 	
@@ -307,6 +328,33 @@ protected:
 	/** Array of information strings to render (Waiting to respawn etc) */
 	TArray<FCanvasTextItem> InfoItems;
 
+	struct FHUDTextKey
+	{
+		FString String;
+		const UFont* Font;
+
+		bool operator==(const FHUDTextKey& Other) const
+		{
+			return Font == Other.Font && String.Equals(Other.String, ESearchCase::CaseSensitive);
+		}
+
+		friend uint32 GetTypeHash(const FHUDTextKey& Key)
+		{
+			return HashCombine(FCrc::StrCrc32(*Key.String), GetTypeHash(Key.Font));
+		}
+	};
+
+	/** measured texts by string and font, the scale is applied by the callers so it is not part of the key */
+	TMap<FHUDTextKey, FShooterHUDText> TextCache;
+
+	/**
+	 * Get the text item text and unscaled size of a string, measuring it only the first time it is drawn.
+	 *
+	 * @param String	The string to draw.
+	 * @param Font		The font it is drawn with.
+	 */
+	FShooterHUDText GetHUDText(const FString& String, const UFont* Font);
+
 	/** Called every time game is started. */
 	virtual void PostInitializeComponents() override;
 
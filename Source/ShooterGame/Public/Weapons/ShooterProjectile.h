@@ -5,6 +5,7 @@
 #include "GameFramework/Actor.h"
 #include "ShooterWeapon_Projectile.h"
 #include "ShooterWeapon_SnowBall.h"
+#include "ShooterActorPool.h"
 #include "ShooterProjectile.generated.h"
 
 class UProjectileMovementComponent;
@@ -12,16 +13,28 @@ class USphereComponent;
 
 // 
 UCLASS(Abstract, Blueprintable)
-class AShooterProjectile : public AActor
+class AShooterProjectile : public AActor, public IShooterPooledActor
 {
 	GENERATED_UCLASS_BODY()
 
 	/** initial setup */
 	virtual void PostInitializeComponents() override;
 
+	/** [server] return to the pool instead of being destroyed */
+	virtual void LifeSpanExpired() override;
+
+	/** [server] reset state left over from the previous use */
+	virtual void OnAcquiredFromPool() override;
+
+	/** [server] stop moving */
+	virtual void OnReleasedToPool() override;
+
 	/** setup velocity */
 	void InitVelocity(FVector& ShootDirection);
 
+	/** get effects for explosion */
+	TSubclassOf<class AShooterExplosionEffect> GetExplosionTemplate() const { return ExplosionTemplate; }
+
 	/** handle hit */
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& HitResult);
@@ -63,10 +76,16 @@ protected:
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_Exploded)
 	bool bExploded;
 
-	/** [client] explosion happened */
+	/** [client] explosion happened, or the projectile was reused from the pool */
 	UFUNCTION()
 	void OnRep_Exploded();
 
+	/** pick up config from the owning weapon and start the life span */
+	void InitProjectile();
+
+	/** restart the movement and effects stopped by the previous use, on the server and on clients */
+	void ResetForReuse();
+
 	void FreezeActors(const UObject* WorldContextObject, const FVector& Origin, float DamageRadius, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser = NULL, AController* InstigatedByController = NULL);
 
 	/** trigger explosion */
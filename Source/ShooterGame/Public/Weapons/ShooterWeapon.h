@@ -266,6 +266,12 @@ class AShooterWeapon : public AActor
 	UPROPERTY(Config)
 	bool bAllowAutomaticWeaponCatchup = true;
 
+	/** actor classes this weapon spawns through UShooterActorPool, to prewarm the pool, by default its projectile and explosion */
+	virtual void GetPooledActorClasses(TArray<UClass*>& OutClasses) const;
+
+	/** projectile spawned through the pool when firing, if any */
+	virtual UClass* GetProjectileClass() const { return nullptr; }
+
 	/** check if weapon has infinite ammo (include owner's cheats) */
 	bool HasInfiniteAmmo() const;
 
@@ -477,6 +483,15 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerHandleFiring();
 
+	/** [server] fire & update ammo for a shot of the remote client */
+	void HandleServerFiring();
+
+	/** whether shots fired by a remote client reach the server through the weapon's own batched RPC instead of ServerHandleFiring */
+	virtual bool UsesShotBatching() const
+	{
+		return false;
+	}
+
 	/** [local + server] handle weapon refire, compensating for slack time if the timer can't sample fast enough */
 	void HandleReFiring();
 
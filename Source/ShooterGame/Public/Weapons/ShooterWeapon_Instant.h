@@ -22,6 +22,98 @@ struct FInstantHitInfo
 	int32 RandomSeed;
 };
 
+/** a single shot of an instant weapon sent by its owning client, see FInstantShotBatch */
+USTRUCT()
+struct FInstantShotData
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** direction of the shot */
+	UPROPERTY()
+	FVector_NetQuantizeNormal ShootDir;
+
+	/** where the shot hit (blocking hits only) */
+	UPROPERTY()
+	FVector_NetQuantize ImpactPoint;
+
+	/** surface normal at the hit (blocking hits only) */
+	UPROPERTY()
+	FVector_NetQuantizeNormal ImpactNormal;
+
+	/** actor that was hit, if any (blocking hits only) */
+	UPROPERTY()
+	AActor* HitActor;
+
+	/** seed used for the spread of the shot */
+	UPROPERTY()
+	int32 RandomSeed;
+
+	/** reticle spread, in hundredths of a degree */
+	UPROPERTY()
+	uint16 QuantizedSpread;
+
+	/** milliseconds between the batch time stamp and this shot */
+	UPROPERTY()
+	uint16 TimeOffset;
+
+	/** did the shot hit anything */
+	UPROPERTY()
+	uint8 bBlockingHit : 1;
+
+	FInstantShotData()
+		: ShootDir(ForceInit)
+		, ImpactPoint(ForceInit)
+		, ImpactNormal(ForceInit)
+		, HitActor(NULL)
+		, RandomSeed(0)
+		, QuantizedSpread(0)
+		, TimeOffset(0)
+		, bBlockingHit(false)
+	{}
+
+	/** reticle spread in degrees */
+	float GetReticleSpread() const
+	{
+		return QuantizedSpread / 100.0f;
+	}
+
+	/** only sends the impact of shots that hit something */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FInstantShotData> : public TStructOpsTypeTraitsBase2<FInstantShotData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/** consecutive shots of an instant weapon, sent once per frame and resent until acknowledged */
+USTRUCT()
+struct FInstantShotBatch
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** sequence number of the first shot, following shots are numbered consecutively */
+	UPROPERTY()
+	int32 FirstShotSequence;
+
+	/** server world time the client was seeing when it fired the first shot */
+	UPROPERTY()
+	float ClientTimeStamp;
+
+	/** the shots, oldest first */
+	UPROPERTY()
+	TArray<FInstantShotData> Shots;
+
+	FInstantShotBatch()
+		: FirstShotSequence(0)
+		, ClientTimeStamp(0.0f)
+	{}
+};
+
 USTRUCT()
 struct FInstantWeaponData
 {
@@ -55,14 +147,14 @@ struct FInstantWeaponData
 	UPROPERTY(EditDefaultsOnly, Category=WeaponStat)
 	TSubclassOf<UDamageType> DamageType;
 
-	/** hit verification: scale for bounding box of hit actor */
-	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
-	float ClientSideHitLeeway;
-
 	/** hit verification: threshold for dot product between view direction and hit direction */
 	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
 	float AllowedViewDotHitDir;
 
+	/** hit verification: distance (in cm) a hit may be outside of the rewound pose of a character, or the bounding box of other actors */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float LagCompensationLeeway;
+
 	/** defaults */
 	FInstantWeaponData()
 	{
@@ -73,8 +165,8 @@ struct FInstantWeaponData
 		WeaponRange = 10000.0f;
 		HitDamage = 10;
 		DamageType = UDamageType::StaticClass();
-		ClientSideHitLeeway = 200.0f;
 		AllowedViewDotHitDir = 0.8f;
+		LagCompensationLeeway = 20.0f;
 	}
 };
 
@@ -87,6 +179,18 @@ class AShooterWeapon_Instant : public AShooterWeapon
 	/** get current spread */
 	float GetCurrentSpread() const;
 
+	/** impact effect */
+	virtual void GetPooledActorClasses(TArray<UClass*>& OutClasses) const override;
+
+	/** [local] sends the queued shots to the server */
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** [local + server] stop weapon fire */
+	virtual void StopFire() override;
+
+	/** [all] start weapon reload */
+	virtual void StartReload(bool bFromReplication = false) override;
+
 protected:
 
 	virtual EAmmoType GetAmmoType() const override
@@ -117,20 +221,59 @@ protected:
 	/** current spread from continuous firing */
 	float CurrentFiringSpread;
 
+	/** [local] shots not acknowledged by the server yet, sent once per frame, split into several batches when there are too many */
+	UPROPERTY(Transient)
+	FInstantShotBatch PendingShotBatch;
+
+	/** [local] client time stamp of each shot in PendingShotBatch */
+	TArray<float> PendingShotTimeStamps;
+
+	/** [local] number of shots at the end of PendingShotBatch that were never sent */
+	int32 NumUnsentShots;
+
+	/** [local] time PendingShotBatch was last sent */
+	float LastShotBatchSendTime;
+
+	/** [server] sequence number of the last shot processed, older shots in a batch are resends */
+	int32 LastProcessedShotSequence;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Weapon usage
 
-	/** server notified of hit from client to verify */
-	UFUNCTION(reliable, server, WithValidation)
-	void ServerNotifyHit(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread);
+	virtual bool UsesShotBatching() const override
+	{
+		return true;
+	}
 
-	/** server notified of miss to show trail FX */
+	/** server notified of the shots fired since the last acknowledged batch */
 	UFUNCTION(unreliable, server, WithValidation)
-	void ServerNotifyMiss(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread);
+	void ServerFireShots(const FInstantShotBatch& Batch);
+
+	/** client notified of the last shot the server processed */
+	UFUNCTION(unreliable, client)
+	void ClientAckShots(int32 LastShotSequence);
+
+	/** [local] queue a shot for the next batch */
+	void QueueShot(const FHitResult& Impact, bool bNotifyHit, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
+
+	/** [local] send the pending shots if there are new ones, or resend them if they weren't acknowledged in time */
+	void FlushShots();
+
+	/** [server] verify a hit reported by the client */
+	void ProcessClientHit(const FHitResult& Impact, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread, float ClientTimeStamp);
+
+	/** [server] show trail FX for a miss reported by the client */
+	void ProcessClientMiss(const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
 
 	/** process the instant hit and notify the server if necessary */
 	void ProcessInstantHit(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
 
+	/** [server] check a client side hit on a moving actor against where it was when the client fired */
+	bool IsClientHitWithinTolerance(const FHitResult& Impact, float ClientTimeStamp) const;
+
+	/** [local] server world time of the poses the client is currently seeing, sent along with hits for lag compensation */
+	float GetClientTimeStamp() const;
+
 	/** continue processing the instant hit, as if it has been confirmed by the server */
 	void ProcessInstantHit_Confirmed(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
 
@@ -68,6 +68,8 @@ protected:
 	/** [local] weapon specific fire implementation */
 	virtual void FireWeapon() override;
 
+	virtual UClass* GetProjectileClass() const override { return ProjectileConfig.ProjectileClass; }
+
 	/** spawn projectile on server */
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerFireProjectile(FVector Origin, FVector_NetQuantizeNormal ShootDir);
@@ -59,7 +59,8 @@ public class ShooterGame : ModuleRules
 				"NetworkReplayStreaming",
 				"NullNetworkReplayStreaming",
 				"HttpNetworkReplayStreaming",
-				"LocalFileNetworkReplayStreaming"
+				"LocalFileNetworkReplayStreaming",
+				"ShooterReplayStreaming"
 			}
 		);
 
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterReplayStreaming.h"
+#include "Misc/Compression.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogShooterReplayStreaming, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("ShooterReplayStreaming"), STATGROUP_ShooterReplayStreaming, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Replay Early Chunk Flushes"), STAT_ShooterReplayEarlyFlushes, STATGROUP_ShooterReplayStreaming);
+
+IMPLEMENT_MODULE(FShooterReplayStreamingFactory, ShooterReplayStreaming)
+
+/** replay chunks are mostly quantized vectors and small integers, zlib is available on every platform we ship */
+static const FName ReplayCompressionFormat = NAME_Zlib;
+
+FShooterReplayStreamer::FShooterReplayStreamer()
+{
+	int32 MaxBufferedRecordKB = 32 * 1024;
+	GConfig->GetInt(TEXT("ShooterReplayStreaming"), TEXT("MaxBufferedRecordKB"), MaxBufferedRecordKB, GEngineIni);
+	MaxBufferedBytes = (int64)MaxBufferedRecordKB * 1024;
+}
+
+void FShooterReplayStreamer::Tick(float DeltaSeconds)
+{
+	FLocalFileNetworkReplayStreamer::Tick(DeltaSeconds);
+
+	// hand the data to a file task now rather than wait for the chunk interval, flushing empties the stream archive
+	if (MaxBufferedBytes > 0 && StreamAr.IsSaving() && StreamAr.TotalSize() > MaxBufferedBytes)
+	{
+		UE_LOG(LogShooterReplayStreaming, Log, TEXT("Replay stream buffer is over %lld KB, flushing the chunk early"), MaxBufferedBytes / 1024);
+		INC_DWORD_STAT(STAT_ShooterReplayEarlyFlushes);
+		FlushStream(GetTotalDemoTime());
+	}
+}
+
+bool FShooterReplayStreamer::CompressBuffer(const TArray<uint8>& InBuffer, FArchive& OutCompressed) const
+{
+	int32 UncompressedSize = InBuffer.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(ReplayCompressionFormat, UncompressedSize);
+
+	TArray<uint8> CompressedBuffer;
+	CompressedBuffer.SetNumUninitialized(CompressedSize);
+
+	if (!FCompression::CompressMemory(ReplayCompressionFormat, CompressedBuffer.GetData(), CompressedSize, InBuffer.GetData(), UncompressedSize))
+	{
+		UE_LOG(LogShooterReplayStreaming, Warning, TEXT("Failed to compress %d bytes of replay data"), UncompressedSize);
+		return false;
+	}
+
+	OutCompressed << UncompressedSize;
+	OutCompressed << CompressedSize;
+	OutCompressed.Serialize(CompressedBuffer.GetData(), CompressedSize);
+
+	return !OutCompressed.IsError();
+}
+
+bool FShooterReplayStreamer::DecompressBuffer(FArchive& InCompressed, TArray<uint8>& OutBuffer) const
+{
+	int32 UncompressedSize = 0;
+	int32 CompressedSize = 0;
+	InCompressed << UncompressedSize;
+	InCompressed << CompressedSize;
+
+	if (InCompressed.IsError() || UncompressedSize < 0 || CompressedSize < 0 || CompressedSize > InCompressed.TotalSize() - InCompressed.Tell())
+	{
+		UE_LOG(LogShooterReplayStreaming, Warning, TEXT("Corrupt compressed replay chunk (%d -> %d bytes)"), CompressedSize, UncompressedSize);
+		return false;
+	}
+
+	TArray<uint8> CompressedBuffer;
+	CompressedBuffer.SetNumUninitialized(CompressedSize);
+	InCompressed.Serialize(CompressedBuffer.GetData(), CompressedSize);
+
+	OutBuffer.SetNumUninitialized(UncompressedSize);
+	return FCompression::UncompressMemory(ReplayCompressionFormat, OutBuffer.GetData(), UncompressedSize, CompressedBuffer.GetData(), CompressedSize);
+}
+
+TSharedPtr<INetworkReplayStreamer> FShooterReplayStreamingFactory::CreateReplayStreamer()
+{
+	TSharedPtr<FShooterReplayStreamer> Streamer = MakeShared<FShooterReplayStreamer>();
+	LocalFileStreamers.Add(Streamer);
+	return Streamer;
+}
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocalFileNetworkReplayStreaming.h"
+
+/**
+ * Local file replay streamer that compresses the replay chunks.
+ *
+ * The local file streamer already hands every chunk it flushes to a file task on the thread pool, the compression
+ * hooks run inside those tasks, so the game thread only pays for copying the recorded bytes out of the stream.
+ * Chunks are written whole, one sequential write per chunk.
+ *
+ * When more than [ShooterReplayStreaming] MaxBufferedRecordKB of recorded data is waiting for the next chunk, the chunk
+ * is flushed early instead, so a busy match costs more chunks rather than memory or dropped frames.
+ */
+class SHOOTERREPLAYSTREAMING_API FShooterReplayStreamer : public FLocalFileNetworkReplayStreamer
+{
+public:
+
+	FShooterReplayStreamer();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	virtual bool SupportsCompression() const override { return true; }
+	virtual bool CompressBuffer(const TArray<uint8>& InBuffer, FArchive& OutCompressed) const override;
+	virtual bool DecompressBuffer(FArchive& InCompressed, TArray<uint8>& OutBuffer) const override;
+
+private:
+
+	/** recorded data above which a chunk is flushed early, 0 for no cap */
+	int64 MaxBufferedBytes;
+};
+
+class FShooterReplayStreamingFactory : public FLocalFileNetworkReplayStreamingFactory
+{
+public:
+
+	virtual TSharedPtr<INetworkReplayStreamer> CreateReplayStreamer() override;
+};
@@ -0,0 +1,23 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Loaded by name through [NetworkReplayStreaming] DefaultFactoryName in DefaultEngine.ini
+
+public class ShooterReplayStreaming : ModuleRules
+{
+	public ShooterReplayStreaming(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[] {
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"NetworkReplayStreaming",
+				"LocalFileNetworkReplayStreaming"
+			}
+		);
+	}
+}